@@ -1,25 +1,38 @@
 vim.g.neogurt = true
 vim.g.neogurt_startup = function() end
 
+local utils = require("utils")
+
+-- events from before ui attach (colorscheme in ginit) are dropped,
+-- the highlights are fetched again once attached
+local function notify(event)
+  local chan_id = utils.get_neogurt_channel(true)
+  if chan_id == nil then return end
+  vim.rpcnotify(chan_id, event)
+end
+
+-- cleared, so sourcing this again (attaching to the same nvim) doesn't add them twice
+local group = vim.api.nvim_create_augroup("Neogurt", { clear = true })
 local autocmd = vim.api.nvim_create_autocmd
 autocmd("VimEnter", {
+  group = group,
   callback = function()
-    vim.rpcnotify(1, "vim_enter")
+    notify("vim_enter")
   end
 })
 autocmd("ColorScheme", {
+  group = group,
   callback = function()
-    vim.rpcnotify(1, "color_scheme")
+    notify("color_scheme")
   end
 })
 -- autocmd("InsertCharPre", {
+--   group = group,
 --   callback = function()
---     vim.rpcnotify(1, "insert_char_pre")
+--     notify("insert_char_pre")
 --   end
 -- })
 
-local utils = require("utils")
-
 -- if value is a type name, the option is required
 local cmds_table = {
   -- sets neogurt options
@@ -56,6 +69,7 @@ local cmds_table = {
     name = "",
     dir = "~/",
     switch_to = true, -- switch to session after creating it
+    address = "", -- attach to a running nvim --listen socket instead of spawning
   },
   -- returns success (bool)
   session_edit = {
@@ -72,6 +86,8 @@ local cmds_table = {
     -- use cmd as the kill command (e.g. qall)
     -- if empty, will force kill session (like session_kill)
     -- if cmd returns an error when run, restart will not happen
+    -- attached sessions (address) detach and reattach, cmd is not run
+    -- so the --listen server keeps running
     cmd = "",
     curr_dir = false, -- use cwd instead of session dir
   },
@@ -98,6 +114,17 @@ local cmds_table = {
     reverse = false,
   },
 
+  -- returns rpc telemetry (read buffer, message queue and unknown redraw
+  -- events per session, shared zone and buffer pools)
+  stats = {},
+
+  -- writes the recorded trace events to path as chrome trace json and starts
+  -- recording if it wasn't (needs a build with -DNEOGURT_TRACE=ON)
+  -- returns success (bool)
+  trace_dump = {
+    path = "string",
+  },
+
   font_size_change = {
     [1] = "number",
     all = false,  -- change in all sessions
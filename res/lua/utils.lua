@@ -84,7 +84,8 @@ M.convert_opts = function(default_opts, opts)
   return true
 end
 
-M.get_neogurt_channel = function()
+-- quiet: no error if neogurt isn't attached (yet)
+M.get_neogurt_channel = function(quiet)
   local uis = vim.api.nvim_list_uis()
   for _, ui in ipairs(uis) do
     local client = vim.api.nvim_get_chan_info(ui.chan).client
@@ -93,7 +94,9 @@ M.get_neogurt_channel = function()
     end
   end
 
-  vim.api.nvim_err_writeln("Cannot find neogurt client")
+  if not quiet then
+    vim.api.nvim_err_writeln("Cannot find neogurt client")
+  end
   return nil
 end
 
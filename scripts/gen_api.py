@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Generates src/nvim/api.hpp from docs/api.txt.
+
+docs/api.txt is nvim's api metadata printed as a lua table:
+  nvim --clean --headless -c 'put =luaeval(\"vim.inspect(vim.fn.api_info())\")' \
+    -c '1d | w! docs/api.txt | q'
+
+usage: scripts/gen_api.py [docs/api.txt] [src/nvim/api.hpp]
+"""
+
+import re
+import sys
+
+# lua table parsing -------------------------------------------
+
+TOKEN = re.compile(r'\s*(?:(\{|\}|=|,)|"((?:[^"\\]|\\.)*)"|([A-Za-z_][A-Za-z0-9_]*)|(-?\d+))')
+
+
+def tokenize(text):
+  tokens = []
+  pos = 0
+  text = text.rstrip()
+  while pos < len(text):
+    m = TOKEN.match(text, pos)
+    if not m:
+      raise SyntaxError(f"unexpected character at {pos}: {text[pos:pos + 20]!r}")
+    pos = m.end()
+    punct, string, ident, number = m.groups()
+    if punct:
+      tokens.append(("punct", punct))
+    elif string is not None:
+      tokens.append(("value", string.encode().decode("unicode_escape")))
+    elif ident in ("true", "false"):
+      tokens.append(("value", ident == "true"))
+    elif ident:
+      tokens.append(("ident", ident))
+    else:
+      tokens.append(("value", int(number)))
+  return tokens
+
+
+def parse(tokens, pos=0):
+  """returns (value, position after it)"""
+  kind, tok = tokens[pos]
+  pos += 1
+  if kind == "value":
+    return tok, pos
+  if tok != "{":
+    raise SyntaxError(f"expected value, got {tok}")
+
+  # tables are either all positional or all keyed in api_info
+  items, fields = [], {}
+  while tokens[pos][1] != "}":
+    kind, tok = tokens[pos]
+    if kind == "ident":
+      if tokens[pos + 1][1] != "=":
+        raise SyntaxError(f"expected = after {tok}")
+      fields[tok], pos = parse(tokens, pos + 2)
+    else:
+      value, pos = parse(tokens, pos)
+      items.append(value)
+    if tokens[pos][1] == ",":
+      pos += 1
+    elif tokens[pos][1] != "}":
+      raise SyntaxError(f"expected , got {tokens[pos][1]}")
+  return (fields if fields else items), pos + 1
+
+
+# c++ types ---------------------------------------------------
+
+# api type -> (parameter type, result type)
+TYPES = {
+  "Integer": ("int64_t", "int64_t"),
+  "Float": ("double", "double"),
+  "Boolean": ("bool", "bool"),
+  "String": ("std::string_view", "std::string"),
+  "Buffer": ("Handle", "Handle"),
+  "Window": ("Handle", "Handle"),
+  "Tabpage": ("Handle", "Handle"),
+  "Object": ("ObjectRef", "Object"),
+  "Dict": ("DictRef", "Dict"),
+  "Dictionary": ("DictRef", "Dict"),
+  "Array": ("ArrayRef", "Array"),
+  "void": (None, "void"),
+}
+
+KEYWORDS = {"end", "delete", "default", "new", "register", "char", "int", "auto"}
+
+
+def cpp_type(api_type, param):
+  m = re.fullmatch(r"ArrayOf\((\w+)(?:, (\d+))?\)", api_type)
+  if m:
+    inner = cpp_type(m.group(1), param)
+    if m.group(2):
+      return f"std::array<{inner}, {m.group(2)}>"
+    return f"const std::vector<{inner}>&" if param else f"std::vector<{inner}>"
+  if api_type not in TYPES:
+    return None  # LuaRef, can't cross rpc
+  return TYPES[api_type][0 if param else 1]
+
+
+def camel(name, upper):
+  parts = name.split("_")
+  first = parts[0].capitalize() if upper else parts[0]
+  result = first + "".join(p.capitalize() for p in parts[1:])
+  return result + "_" if result in KEYWORDS else result
+
+
+# generation --------------------------------------------------
+
+def generate(api):
+  functions = []
+  for fn in api["functions"]:
+    name = fn["name"]
+    if "deprecated_since" in fn or name.startswith("nvim__"):
+      continue
+    params = [(cpp_type(t, True), camel(n, False)) for t, n in fn["parameters"]]
+    result = cpp_type(fn["return_type"], False)
+    if result is None or any(t is None for t, _ in params):
+      continue
+    functions.append((name, params, result, fn["since"]))
+  functions.sort(key=lambda f: f[0])
+
+  version = api["version"]
+  out = []
+  w = out.append
+  w("// generated by scripts/gen_api.py from docs/api.txt, do not edit")
+  w(f"// nvim {version['major']}.{version['minor']}.{version['patch']}, "
+    f"api level {version['api_level']}")
+  w("#pragma once")
+  w("")
+  w('#include "./api_types.hpp"')
+  w("#include <array>")
+  w("#include <cstdint>")
+  w("#include <string_view>")
+  w("#include <vector>")
+  w("")
+  w("namespace api {")
+  w("")
+  w("enum class Method : uint16_t {")
+  for name, *_ in functions:
+    w(f"  {camel(name.removeprefix('nvim_'), True)},")
+  w("};")
+  w("")
+  w(f"inline constexpr std::array<std::string_view, {len(functions)}> methodNames{{")
+  for name, *_ in functions:
+    w(f'  "{name}",')
+  w("};")
+  w("")
+  w("constexpr std::string_view MethodName(Method method) {")
+  w("  return methodNames[size_t(method)];")
+  w("}")
+
+  for name, params, result, since in functions:
+    struct = camel(name.removeprefix("nvim_"), True)
+    w("")
+    w(f"// since api level {since}")
+    w(f"struct {struct} {{")
+    w(f"  static constexpr Method method = Method::{struct};")
+    w(f'  static constexpr std::string_view methodName = "{name}";')
+    w(f"  using Result = {result};")
+    for type, param in params:
+      w(f"  {type} {param};")
+    w("")
+    w("  template <typename Stream>")
+    w("  void msgpack_pack(msgpack::packer<Stream>& o) const {")
+    w(f"    o.pack_array({len(params)});")
+    for _, param in params:
+      w(f"    o.pack({param});")
+    w("  }")
+    w("};")
+
+  w("")
+  w("} // namespace api")
+  return "\n".join(out) + "\n"
+
+
+def main():
+  src = sys.argv[1] if len(sys.argv) > 1 else "docs/api.txt"
+  dst = sys.argv[2] if len(sys.argv) > 2 else "src/nvim/api.hpp"
+  with open(src) as f:
+    api, _ = parse(tokenize(f.read()))
+  with open(dst, "w") as f:
+    f.write(generate(api))
+
+
+if __name__ == "__main__":
+  main()
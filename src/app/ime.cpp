@@ -40,8 +40,10 @@ void ImeHandler::Update() {
     int u32idx = 0;
     int end = start + (length != -1 ? length : 0);
 
+    // cells hold views into graphemes
+    auto graphemes = SplitByGraphemes(text);
     auto cells =
-      SplitByGraphemes(text) |
+      graphemes |
       std::views::transform([&, this](const GraphemeInfo& info) {
         int hlId = imeNormalHlId;
         if (start != -1) {
@@ -76,7 +78,7 @@ void ImeHandler::Update() {
       .grid = imeGrid,
       .row = 0,
       .colStart = 0,
-      .cells = std::move(cells),
+      .cells = cells,
       .wrap = false,
     });
     editorState->winManager.FloatPos({
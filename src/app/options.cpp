@@ -30,6 +30,10 @@ std::expected<StartupOptions, int> StartupOptions::LoadFromCommandLine(int argc,
 
     ("interactive,i", DEFAULT_VAL(interactive), "Use interactive shell")
     ("multigrid", DEFAULT_VAL(multigrid), "Use multigrid")
+    ("shared_reactor", DEFAULT_VAL(sharedReactor), "Run rpc io of all sessions on one thread")
+    ("record_rpc", DEFAULT_VAL(recordRpc), "Record rpc input to <path>.<session id>, for replay_bench")
+    ("server", DEFAULT_VAL(server), "Attach to a running nvim --listen <path> socket")
+    ("trace", DEFAULT_VAL(trace), "Record trace events, written to <path> on exit")
   ;
 
   po::variables_map vm;
@@ -56,6 +60,10 @@ std::expected<StartupOptions, int> StartupOptions::LoadFromCommandLine(int argc,
     }
     LOAD(interactive);
     LOAD(multigrid);
+    LOAD(sharedReactor);
+    LOAD(recordRpc);
+    LOAD(server);
+    LOAD(trace);
 
   } catch (const po::error& ex) {
     std::cerr << "Error: " << ex.what() << "\n";
@@ -1,9 +1,18 @@
 #pragma once
 #include <expected>
+#include <string>
 
 struct StartupOptions {
   bool interactive = true;
   bool multigrid = true;
+  bool sharedReactor = false;
+  // records each session's rpc input to <recordRpc>.<session id>
+  std::string recordRpc;
+  // attach the first session to nvim --listen <server> instead of spawning
+  std::string server;
+  // records trace events from startup, written as chrome trace json to
+  // <trace> on exit (needs a NEOGURT_TRACE build)
+  std::string trace;
 
   static std::expected<StartupOptions, int> LoadFromCommandLine(int argc, char** argv);
 };
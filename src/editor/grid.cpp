@@ -1,32 +1,57 @@
 #include "./grid.hpp"
 #include "utils/logger.hpp"
 #include <algorithm>
+#include <utility>
+
+GraphemeTable::GraphemeTable() {
+  for (Id id = 0; id < asciiEnd; id++) {
+    strings.emplace_back(id == empty ? 0 : 1, char(id));
+  }
+}
+
+GraphemeTable::Id GraphemeTable::InternSlow(std::string_view text) {
+  auto it = ids.find(text);
+  if (it != ids.end()) return it->second;
+
+  Id id = strings.size();
+  ids.emplace(strings.emplace_back(text), id);
+  return id;
+}
+
+void GridManager::RebuildGraphemes() {
+  auto old = std::exchange(graphemes, std::make_unique<GraphemeTable>());
+  for (auto& [id, grid] : grids) {
+    grid.graphemes = graphemes.get();
+    for (size_t i = 0; i < grid.lines.Size(); i++) {
+      for (auto& cell : grid.lines[i]) {
+        cell.grapheme = graphemes->Intern(old->Text(cell.grapheme));
+      }
+    }
+  }
+  graphemeLimit = std::max(graphemeLimit, graphemes->Size() * 2);
+}
 
 void GridManager::Resize(const event::GridResize& e) {
   auto [it, first] = grids.try_emplace(e.grid);
   auto& grid = it->second;
 
   if (first) {
-    grid.lines = Grid::Lines(e.height, Grid::Line(e.width, Grid::Cell{" "}));
+    grid.lines = Grid::Lines(e.height, Grid::Line(e.width, Grid::Cell{}));
+    grid.graphemes = graphemes.get();
   } else {
-    // TODO: perhaps add RingBuffer::Resize for cleaner code
-    // copy old lines over when resizing
-    int minWidth = std::min(grid.width, e.width);
-    int minHeight = std::min(grid.height, e.height);
-
-    auto oldLines(std::move(grid.lines));
-    grid.lines = Grid::Lines(e.height, Grid::Line(e.width, Grid::Cell{" "}));
-
-    for (int i = 0; i < minHeight; i++) {
-      auto& oldLine = oldLines[i];
-      auto& newLine = grid.lines[i];
-      std::copy(oldLine.begin(), oldLine.begin() + minWidth, newLine.begin());
+    // keep the old lines and their allocations
+    grid.lines.Resize(e.height, Grid::Line(e.width, Grid::Cell{}));
+    if (e.width != grid.width) {
+      for (size_t i = 0; i < grid.lines.Size(); i++) {
+        grid.lines[i].resize(e.width, Grid::Cell{});
+      }
     }
   }
 
   grid.width = e.width;
   grid.height = e.height;
 
+  grid.damage.Resize(e.height);
   grid.dirty = true;
 }
 
@@ -40,11 +65,10 @@ void GridManager::Clear(const event::GridClear& e) {
 
   for (size_t i = 0; i < grid.lines.Size(); i++) {
     auto& line = grid.lines[i];
-    for (auto& cell : line) {
-      cell = Grid::Cell{" "};
-    }
+    std::ranges::fill(line, Grid::Cell{});
   }
 
+  grid.damage.AddAll();
   grid.dirty = true;
 }
 
@@ -56,8 +80,10 @@ void GridManager::Line(const event::GridLine& e) {
   }
   auto& grid = it->second;
 
+  if (graphemes->Size() >= graphemeLimit) RebuildGraphemes();
+
   auto& line = grid.lines[e.row];
-  size_t col = e.colStart;
+  auto* dest = line.data() + e.colStart;
   int recentHlId = 0;
 
   for (size_t i = 0; i < e.cells.size(); i++) {
@@ -66,25 +92,21 @@ void GridManager::Line(const event::GridLine& e) {
       recentHlId = *eventCell.hlId;
     }
 
+    Grid::Cell cell{
+      .grapheme = graphemes->Intern(eventCell.text),
+      .hlId = recentHlId,
+    };
     if (eventCell.repeat) {
-      for (int j = 0; j < eventCell.repeat; j++) {
-        auto& cell = line[col];
-        cell.text = eventCell.text;
-        cell.hlId = recentHlId;
-        cell.doubleWidth = false;
-        col++;
-      }
+      dest = std::fill_n(dest, *eventCell.repeat, cell);
     } else {
-      auto& cell = line[col];
-      cell.text = eventCell.text;
-      cell.hlId = recentHlId;
       // "The right cell of a double-width char will be represented as the empty
       // string. Double-width chars never use repeat."
       cell.doubleWidth = i + 1 < e.cells.size() && e.cells[i + 1].text.empty();
-      col++;
+      *dest++ = cell;
     }
   }
 
+  grid.damage.Add(e.row, e.row + 1);
   grid.dirty = true;
 }
 
@@ -98,7 +120,11 @@ void GridManager::Scroll(const event::GridScroll& e) {
 
   if (e.top == 0 && e.bot == grid.height && e.left == 0 && e.right == grid.width && e.cols == 0) {
     grid.lines.Scroll(e.rows);
+  } else if (e.left == 0 && e.right == grid.width && e.cols == 0) {
+    // whole lines, swap them instead of copying cells
+    grid.lines.Scroll(e.top, e.bot, e.rows);
   } else {
+    // cells are trivially copyable, so std::copy is a memmove per line
     if (e.rows > 0) {
       // scrolling down, move lines up
       int top = e.top;
@@ -121,9 +147,17 @@ void GridManager::Scroll(const event::GridScroll& e) {
     }
   }
 
+  grid.damage.Scroll(e.top, e.bot, e.rows, e.left == 0 && e.right == grid.width);
   grid.dirty = true;
 }
 
+void GridManager::DamageAll() {
+  for (auto& [id, grid] : grids) {
+    grid.damage.AddAll();
+    grid.dirty = true;
+  }
+}
+
 void GridManager::Destroy(const event::GridDestroy& e) {
   auto removed = grids.erase(e.grid);
   if (removed == 0) {
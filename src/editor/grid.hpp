@@ -2,35 +2,219 @@
 
 #include "utils/ring_buffer.hpp"
 #include "event/ui_parse.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 struct Win; // forward decl
 
+// Interns the text of grid cells, cells store the id instead of a string.
+// A single ascii char is its own id, so the common case never hashes.
+class GraphemeTable {
+public:
+  using Id = uint32_t;
+  static constexpr Id empty = 0; // right half of a double width char
+  static constexpr Id space = ' ';
+
+  GraphemeTable();
+
+  Id Intern(std::string_view text) {
+    if (text.size() == 1 && uint8_t(text[0]) < asciiEnd) return uint8_t(text[0]);
+    if (text.empty()) return empty;
+    return InternSlow(text);
+  }
+  // stays valid while the table lives (GridManager replaces it when it
+  // rebuilds it, not in the middle of a frame)
+  const std::string& Text(Id id) const {
+    return strings[id];
+  }
+  size_t Size() const {
+    return strings.size();
+  }
+
+private:
+  static constexpr Id asciiEnd = 128;
+  // [0, asciiEnd) are the ascii chars, interned ones follow
+  std::deque<std::string> strings;
+  // keys point into strings
+  std::unordered_map<std::string_view, Id> ids;
+
+  Id InternSlow(std::string_view text);
+};
+
+// rows of a grid changed since it was last rendered
+class RowDamage {
+  enum : uint8_t {
+    Changed = 1, // cells were written
+    Moved = 2,   // cells came from another row by a scroll
+  };
+  std::vector<uint8_t> rows;
+  // hull of the damaged rows, empty if first >= last
+  int first = INT_MAX;
+  int last = 0;
+
+  // net rows scrolled, all scrolls share one region (else moved rows are
+  // changed instead)
+  int scrolled = 0;
+  int scrollTop = 0;
+  int scrollBot = 0;
+
+  void Extend(int start, int end) {
+    first = std::min(first, start);
+    last = std::max(last, end);
+  }
+
+public:
+  // damages every row
+  void Resize(int height) {
+    rows.assign(height, Changed);
+    first = 0;
+    last = height;
+    scrolled = 0;
+  }
+
+  void Add(int start, int end) {
+    start = std::max(start, 0);
+    end = std::min(end, int(rows.size()));
+    if (start >= end) return;
+    for (int row = start; row < end; row++) rows[row] |= Changed;
+    Extend(start, end);
+  }
+  void AddAll() {
+    Add(0, rows.size());
+  }
+
+  // rows [top, bot) move up by n (down if negative), their damage moves
+  // along and the rows left behind are changed. set fullWidth if whole
+  // rows move, else the region is just changed.
+  void Scroll(int top, int bot, int n, bool fullWidth) {
+    top = std::max(top, 0);
+    bot = std::min(bot, int(rows.size()));
+    if (top >= bot) return;
+    if (scrolled != 0 && (top != scrollTop || bot != scrollBot)) {
+      // moved rows of the other region can't be told apart, give up on them
+      for (int row = first; row < last; row++) {
+        if (rows[row] & Moved) rows[row] = Changed;
+      }
+      scrolled = 0;
+    }
+    if (!fullWidth || std::abs(n) >= bot - top) {
+      Add(top, bot);
+      return;
+    }
+
+    if (n > 0) {
+      for (int row = top; row < bot - n; row++) rows[row] = rows[row + n] | Moved;
+      std::fill(rows.begin() + bot - n, rows.begin() + bot, Changed);
+    } else {
+      for (int row = bot - 1; row >= top - n; row--) rows[row] = rows[row + n] | Moved;
+      std::fill(rows.begin() + top, rows.begin() + top - n, Changed);
+    }
+    Extend(top, bot);
+    scrolled += n;
+    scrollTop = top;
+    scrollBot = bot;
+  }
+
+  bool operator[](int row) const {
+    return row >= first && row < last && rows[row];
+  }
+  bool IsChanged(int row) const {
+    return row >= first && row < last && (rows[row] & Changed);
+  }
+  bool IsMoved(int row) const {
+    return row >= first && row < last && (rows[row] & Moved);
+  }
+  // net rows moved by scrolls
+  int Scrolled() const {
+    return scrolled;
+  }
+  bool Empty() const {
+    return first >= last;
+  }
+
+  void Clear() {
+    if (!Empty()) std::fill(rows.begin() + first, rows.begin() + last, 0);
+    first = INT_MAX;
+    last = 0;
+    scrolled = 0;
+  }
+
+  // calls func(start, end) for each run of damaged rows within [start, end)
+  void ForEachRun(int start, int end, auto&& func) const {
+    start = std::max(start, first);
+    end = std::min(end, last);
+    for (int row = start; row < end;) {
+      if (!rows[row]) {
+        row++;
+        continue;
+      }
+      int runEnd = row + 1;
+      while (runEnd < end && rows[runEnd]) runEnd++;
+      func(row, runEnd);
+      row = runEnd;
+    }
+  }
+};
+
 struct Grid {
   int width;
   int height;
 
+  // trivially copyable, so lines are filled and copied with memset/memmove
   struct Cell {
-    std::string text;
-    int hlId;
-    bool doubleWidth;
+    GraphemeTable::Id grapheme = GraphemeTable::space;
+    int hlId : 31 = 0;
+    bool doubleWidth : 1 = false;
+
+    bool operator==(const Cell&) const = default;
   };
   using Line = std::vector<Cell>;
   using Lines = RingBuffer<Line>;
   Lines lines;
 
+  // owned by the GridManager
+  const GraphemeTable* graphemes;
+
+  // set with any damage, RenderToWindow only redraws damaged rows
   bool dirty;
+  RowDamage damage;
 
   bool ValidCoords(int row, int col) const {
     return row >= 0 && row < height && col >= 0 && col < width;
   }
+
+  const std::string& Text(const Cell& cell) const {
+    return graphemes->Text(cell.grapheme);
+  }
 };
+static_assert(sizeof(Grid::Cell) == 8);
+static_assert(std::is_trivially_copyable_v<Grid::Cell>);
 
 struct GridManager {
   std::unordered_map<int, Grid> grids;
+  // shared by the session's grids, on the heap so grids can point to it
+  std::unique_ptr<GraphemeTable> graphemes = std::make_unique<GraphemeTable>();
+  // the table only grows, past this many entries it's rebuilt from the
+  // cells of the live grids (like nvim's schar cache). raised if the live
+  // grids alone come close, so it isn't rebuilt over and over
+  size_t graphemeLimit = 1 << 16;
 
   void Resize(const event::GridResize& e);
   void Clear(const event::GridClear& e);
   void Line(const event::GridLine& e);
   void Scroll(const event::GridScroll& e);
   void Destroy(const event::GridDestroy& e);
+  // every cell needs a redraw (default colors or a used highlight changed)
+  void DamageAll();
+
+private:
+  void RebuildGraphemes();
 };
@@ -1,7 +1,9 @@
 #include "./highlight.hpp"
+#include "editor/grid.hpp"
 #include "utils/color.hpp"
 #include "utils/logger.hpp"
 #include "glm/gtx/string_cast.hpp"
+#include <algorithm>
 
 static int VariantAsInt(const msgpack::type::variant& v) {
   if (v.is_uint64_t()) return v.as_uint64_t();
@@ -10,48 +12,65 @@ static int VariantAsInt(const msgpack::type::variant& v) {
   return 0;
 }
 
+Highlight Highlight::FromAttrs(const event::HlAttrs& attrs) {
+  Highlight hl{
+    .reverse = attrs.reverse,
+    .italic = attrs.italic,
+    .bold = attrs.bold,
+    .strikethrough = attrs.strikethrough,
+    .underline = attrs.underline,
+    .bgAlpha = 1 - (attrs.blend / 100.0f),
+    // TODO: make urls clickable
+    .url = std::string(attrs.url),
+  };
+  if (attrs.foreground) hl.foreground = IntToColor(*attrs.foreground);
+  if (attrs.background) hl.background = IntToColor(*attrs.background);
+  if (attrs.special) hl.special = IntToColor(*attrs.special);
+  if (hl.background) {
+    hl.background->a = hl.bgAlpha;
+  }
+
+  return hl;
+}
+
 Highlight Highlight::FromDesc(const event::HlAttrMap& hlDesc) {
-  Highlight hl{};
+  event::HlAttrs attrs;
 
   for (const auto& [key, value] : hlDesc) {
     if (key == "foreground" || key == "fg") {
-      hl.foreground = IntToColor(VariantAsInt(value));
+      attrs.foreground = VariantAsInt(value);
     } else if (key == "background" || key == "bg") {
-      hl.background = IntToColor(VariantAsInt(value));
+      attrs.background = VariantAsInt(value);
     } else if (key == "special" || key == "sp") {
-      hl.special = IntToColor(VariantAsInt(value));
+      attrs.special = VariantAsInt(value);
     } else if (key == "reverse") {
-      hl.reverse = value.as_bool();
+      attrs.reverse = value.as_bool();
     } else if (key == "italic") {
-      hl.italic = value.as_bool();
+      attrs.italic = value.as_bool();
     } else if (key == "bold") {
-      hl.bold = value.as_bool();
+      attrs.bold = value.as_bool();
     } else if (key == "strikethrough") {
-      hl.strikethrough = value.as_bool();
+      attrs.strikethrough = value.as_bool();
     } else if (key == "underline") {
-      hl.underline = UnderlineType::Underline;
+      attrs.underline = UnderlineType::Underline;
     } else if (key == "undercurl") {
-      hl.underline = UnderlineType::Undercurl;
+      attrs.underline = UnderlineType::Undercurl;
     } else if (key == "underdouble") {
-      hl.underline = UnderlineType::Underdouble;
+      attrs.underline = UnderlineType::Underdouble;
     } else if (key == "underdotted") {
-      hl.underline = UnderlineType::Underdotted;
+      attrs.underline = UnderlineType::Underdotted;
     } else if (key == "underdashed") {
-      hl.underline = UnderlineType::Underdashed;
+      attrs.underline = UnderlineType::Underdashed;
     } else if (key == "blend") {
-      hl.bgAlpha = 1 - (VariantAsInt(value) / 100.0f);
+      attrs.blend = VariantAsInt(value);
     } else if (key == "url") {
-      // TODO: make urls clickable
-      hl.url = value.as_string();
+      attrs.url = value.as_string();
     } else if (key == "nocombine") {
       // NOTE: ignore for now
     }
   }
-  if (hl.background) {
-    hl.background->a = hl.bgAlpha;
-  }
 
-  return hl;
+  return FromAttrs(attrs);
 }
 
 HlManager::HlManager() {
@@ -60,6 +79,7 @@ HlManager::HlManager() {
   hl.background = {0, 0, 0, 1};
   hl.special = {0, 0, 0, 1};
   defaultBg = {0, 0, 0, 1};
+  ResolveAll();
 }
 
 void HlManager::DefaultColorsSet(const event::DefaultColorsSet& e) {
@@ -70,10 +90,31 @@ void HlManager::DefaultColorsSet(const event::DefaultColorsSet& e) {
   }
   defaultBg = IntToColor(e.rgbBg);
   hl.special = IntToColor(e.rgbSp);
+  ResolveAll();
 }
 
 void HlManager::HlAttrDefine(const event::HlAttrDefine& e) {
-  hlTable[e.id] = Highlight::FromDesc(e.rgbAttrs);
+  SetHighlight(e.id, Highlight::FromAttrs(e.rgbAttrs));
+}
+
+void HlManager::SetHighlight(int id, const Highlight& hl) {
+  auto [it, inserted] = hlTable.insert_or_assign(id, hl);
+  // redefined, cells already drawn with it have the old colors
+  if (!inserted && gridManager != nullptr) gridManager->DamageAll();
+  if (id == 0) {
+    ResolveAll();
+    return;
+  }
+  if (id < -reservedIds) {
+    LOG_WARN("HlManager::SetHighlight: id {} out of range", id);
+    return;
+  }
+
+  size_t index = id + reservedIds;
+  if (index >= renderTable.size()) {
+    renderTable.resize(index + 1, undefinedHl);
+  }
+  renderTable[index] = Resolve(hl);
 }
 
 void HlManager::SetOpacity(float opacity, int bgColor) {
@@ -86,27 +127,51 @@ void HlManager::SetOpacity(float opacity, int bgColor) {
     hl.bgAlpha = std::clamp(opacity, 0.0f, 1.0f);
     hl.background->a = hl.bgAlpha;
   }
+  ResolveAll();
+}
+
+HlRender HlManager::Resolve(const Highlight& hl) const {
+  return {
+    .foreground = GetForeground(hl),
+    .background = GetBackground(hl),
+    .special = GetSpecial(hl),
+    .underline = hl.underline,
+    .italic = hl.italic,
+    .bold = hl.bold,
+    .strikethrough = hl.strikethrough,
+  };
+}
+
+void HlManager::ResolveAll() {
+  undefinedHl = Resolve(Highlight{});
+  renderTable.resize(std::max(renderTable.size(), size_t(reservedIds + 1)));
+  for (size_t index = 0; index < renderTable.size(); index++) {
+    auto it = hlTable.find(int(index) - reservedIds);
+    renderTable[index] = it != hlTable.end() ? Resolve(it->second) : undefinedHl;
+  }
+  // cells without their own colors use the default ones
+  if (gridManager != nullptr) gridManager->DamageAll();
 }
 
-glm::vec4 HlManager::GetDefaultBackground() {
+glm::vec4 HlManager::GetDefaultBackground() const {
   return hlTable.at(0).background.value();
 }
 
-glm::vec4 HlManager::GetForeground(const Highlight& hl) {
+glm::vec4 HlManager::GetForeground(const Highlight& hl) const {
   if (hl.reverse) {
     return hl.background.value_or(hlTable.at(0).background.value());
   }
   return hl.foreground.value_or(hlTable.at(0).foreground.value());
 }
 
-glm::vec4 HlManager::GetBackground(const Highlight& hl) {
+glm::vec4 HlManager::GetBackground(const Highlight& hl) const {
   if (hl.reverse) {
     return hl.foreground.value_or(hlTable.at(0).foreground.value());
   }
   return hl.background.value_or(hlTable.at(0).background.value());
 }
 
-glm::vec4 HlManager::GetSpecial(const Highlight& hl) {
+glm::vec4 HlManager::GetSpecial(const Highlight& hl) const {
   // use foreground if no special
   return hl.special.value_or(GetForeground(hl));
 }
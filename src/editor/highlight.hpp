@@ -6,16 +6,11 @@
 #include <optional>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
-struct StrikethroughTag {};
+struct GridManager; // forward decl
 
-enum class UnderlineType : uint32_t {
-  Underline,
-  Undercurl,
-  Underdouble,
-  Underdotted,
-  Underdashed,
-};
+struct StrikethroughTag {};
 
 struct Highlight {
   std::optional<glm::vec4> foreground;
@@ -29,6 +24,7 @@ struct Highlight {
   float bgAlpha = 1; // 0 - 1
   std::string url;
 
+  static Highlight FromAttrs(const event::HlAttrs& attrs);
   static Highlight FromDesc(const event::HlAttrMap& hlDesc);
 };
 template <>
@@ -45,18 +41,53 @@ struct std::formatter<Highlight> {
   }
 };
 
+// what rendering a cell needs, colors already resolved against reverse and
+// the default colors, one cache line per highlight
+struct alignas(64) HlRender {
+  glm::vec4 foreground;
+  glm::vec4 background;
+  glm::vec4 special;
+  std::optional<UnderlineType> underline;
+  bool italic;
+  bool bold;
+  bool strikethrough;
+};
+static_assert(sizeof(HlRender) == 64);
+
 struct HlManager {
+  // damaged when colors of cells already drawn change
+  GridManager* gridManager = nullptr;
+
+  // highlights as nvim defined them
   std::unordered_map<int, Highlight> hlTable;
   glm::vec4 defaultBg;
 
+  // negative ids down to -reservedIds are ours (ime highlights)
+  static constexpr int reservedIds = 2;
+  // dense, indexed by id + reservedIds, kept in sync with hlTable and the
+  // default colors
+  std::vector<HlRender> renderTable;
+  HlRender undefinedHl; // ids nvim hasn't defined
+
   HlManager();
   void DefaultColorsSet(const event::DefaultColorsSet& e);
   void HlAttrDefine(const event::HlAttrDefine& e);
+  void SetHighlight(int id, const Highlight& hl);
 
   void SetOpacity(float opacity, int bgColor);
 
-  glm::vec4 GetDefaultBackground();
-  glm::vec4 GetForeground(const Highlight& hl);
-  glm::vec4 GetBackground(const Highlight& hl);
-  glm::vec4 GetSpecial(const Highlight& hl);
+  const HlRender& Get(int id) const {
+    size_t index = id + reservedIds;
+    return index < renderTable.size() ? renderTable[index] : undefinedHl;
+  }
+
+  glm::vec4 GetDefaultBackground() const;
+  glm::vec4 GetForeground(const Highlight& hl) const;
+  glm::vec4 GetBackground(const Highlight& hl) const;
+  glm::vec4 GetSpecial(const Highlight& hl) const;
+
+private:
+  HlRender Resolve(const Highlight& hl) const;
+  // after the default colors changed, damages every grid
+  void ResolveAll();
 };
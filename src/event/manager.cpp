@@ -22,14 +22,20 @@ void EventManager::ExecuteTasks() {
 }
 
 void EventManager::ProcessSessionEvents(SessionHandle& session) {
-  session->uiEvents.numFlushes = 0;
+  // batches already parsed on the reader thread
+  session->uiEvents->TakeReady();
 
   auto& client = *session->nvim.client;
   auto& nvim = session->nvim;
 
-  while (client.HasMessage()) {
-    rpc::Message& message = client.FrontMessage();
+  // no vim_enter from an attached nvim, skip the startup hook too
+  if (session->attachSetup) {
+    SetImeHighlight(session);
+    session->attachSetup = false;
+  }
 
+  // take everything queued so far in one go
+  client.DrainMessages([&](rpc::Message& message) {
     switch (message.index()) {
       case 0: { // Request
         auto& request = *std::get_if<rpc::Request>(&message);
@@ -59,7 +65,8 @@ void EventManager::ProcessSessionEvents(SessionHandle& session) {
           }
 
         } else if (notif.method == "redraw") {
-          ParseUiRedraw(notif.params, session->uiEvents);
+          // only queued if Nvim::uiEvents wasn't set
+          ParseUiRedraw(notif.rawParams, std::move(notif._zone), *session->uiEvents);
 
         } else if (notif.method == "color_scheme") {
           SetImeHighlight(session);
@@ -73,9 +80,7 @@ void EventManager::ProcessSessionEvents(SessionHandle& session) {
         break;
       }
     }
-
-    client.PopMessage();
-  }
+  });
 }
 
 void EventManager::SetImeHighlight(SessionHandle& session) {
@@ -86,13 +91,14 @@ void EventManager::SetImeHighlight(SessionHandle& session) {
     ),
     [weakSession = std::weak_ptr(session)](auto& result) {
       if (auto session = weakSession.lock()) {
-        auto& [imeNormalHlObj, imeSelectedHlObj] = result;
+        auto& [imeNormalHl, imeSelectedHl] = result;
         ImeHandler::imeNormalHlId = -1;
         ImeHandler::imeSelectedHlId = -2;
-        session->editorState.hlManager.hlTable[ImeHandler::imeNormalHlId] =
-          Highlight::FromDesc(imeNormalHlObj->convert());
-        session->editorState.hlManager.hlTable[ImeHandler::imeSelectedHlId] =
-          Highlight::FromDesc(imeSelectedHlObj->convert());
+        auto& hlManager = session->editorState.hlManager;
+        hlManager.SetHighlight(ImeHandler::imeNormalHlId, Highlight::FromDesc(imeNormalHl));
+        hlManager.SetHighlight(
+          ImeHandler::imeSelectedHlId, Highlight::FromDesc(imeSelectedHl)
+        );
       }
     }
   );
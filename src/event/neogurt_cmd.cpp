@@ -1,5 +1,6 @@
 #include "./neogurt_cmd.hpp"
 #include "session/manager.hpp"
+#include "utils/trace.hpp"
 #include <string_view>
 
 void ProcessNeogurtCmd(
@@ -27,6 +28,7 @@ void ProcessNeogurtCmd(
         .name = conv("name"),
         .dir = conv("dir"),
         .switchTo = conv("switch_to"),
+        .address = conv("address"),
       });
       request.SetResult(id);
 
@@ -69,6 +71,15 @@ void ProcessNeogurtCmd(
       });
       request.SetResult(list);
 
+    } else if (cmd == "stats") {
+      request.SetResult(sessionManager.Stats());
+
+    } else if (cmd == "trace_dump") {
+      std::string path = conv("path");
+      bool success = trace::WriteChromeTrace(path);
+      trace::SetEnabled(true);
+      request.SetResult(success);
+
     } else if (cmd == "font_size_change") {
       sessionManager.FontSizeChange(conv("arg1"), conv("all"));
       request.SetResult(nil_t());
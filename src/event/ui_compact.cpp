@@ -0,0 +1,221 @@
+#include "./ui_compact.hpp"
+#include "utils/trace.hpp"
+#include "utils/variant.hpp"
+#include <algorithm>
+
+using namespace event;
+
+// number of columns written
+static int LineWidth(const GridLine& e) {
+  int width = 0;
+  for (const auto& cell : e.cells) width += cell.repeat ? *cell.repeat : 1;
+  return width;
+}
+
+// adds span to sorted, merged spans
+static void AddSpan(std::vector<std::pair<int, int>>& spans, std::pair<int, int> span) {
+  auto it = std::ranges::lower_bound(spans, span.first, {}, [](auto& s) { return s.second; });
+  auto end = it;
+  for (; end != spans.end() && end->first <= span.second; end++) {
+    span.first = std::min(span.first, end->first);
+    span.second = std::max(span.second, end->second);
+  }
+  it = spans.erase(it, end);
+  spans.insert(it, span);
+}
+
+// rewrites e to only write columns [keepStart, keepEnd), returns columns dropped
+static int TrimLine(GridLine& e, int keepStart, int keepEnd, Arena& arena) {
+  auto cells = arena.MakeArray<GridLine::Cell>(e.cells.size());
+  size_t numCells = 0;
+  int col = e.colStart;
+  int recentHlId = 0;
+  int kept = 0;
+
+  for (size_t i = 0; i < e.cells.size(); i++) {
+    const auto& cell = e.cells[i];
+    if (cell.hlId) recentHlId = *cell.hlId;
+    int width = cell.repeat ? *cell.repeat : 1;
+    // a double width char is only marked as such if its right half follows
+    if (col + width == keepEnd && i + 1 < e.cells.size() && e.cells[i + 1].text.empty()) {
+      keepEnd++;
+    }
+
+    int start = std::max(col, keepStart);
+    int end = std::min(col + width, keepEnd);
+    if (start < end) {
+      if (numCells == 0) e.colStart = start;
+      auto& out = cells[numCells++];
+      out.text = cell.text;
+      // the first cell can't inherit the hl of dropped ones
+      out.hlId = numCells == 1 ? recentHlId : cell.hlId;
+      if (cell.repeat) out.repeat = end - start;
+      kept += end - start;
+    }
+    col += width;
+  }
+
+  int dropped = LineWidth(e) - kept;
+  e.cells = cells.first(numCells);
+  return dropped;
+}
+
+GridEventCompactor::GridState& GridEventCompactor::State(int grid) {
+  return grids.try_emplace(grid).first->second;
+}
+
+GridEventCompactor::Stats
+GridEventCompactor::Compact(std::vector<UiEvent*>& gridEvents, Arena& arena) {
+  TRACE_SCOPE("compact_grid_events");
+  Stats stats;
+  Backward(gridEvents, arena, stats);
+  std::erase(gridEvents, nullptr);
+  Forward(gridEvents, arena, stats);
+  std::erase(gridEvents, nullptr);
+  TRACE_COUNTER("compacted_cells", stats.droppedCells);
+  return stats;
+}
+
+// later events hide earlier ones, so walk from the end
+void GridEventCompactor::Backward(
+  std::vector<UiEvent*>& gridEvents, Arena& arena, Stats& stats
+) {
+  for (auto& [_, state] : grids) {
+    state.replaced = false;
+    for (auto& spans : state.covered) spans.clear();
+  }
+
+  for (auto it = gridEvents.rbegin(); it != gridEvents.rend(); it++) {
+    auto*& event = *it;
+    bool drop = false;
+
+    std::visit(overloaded{
+      [&](GridLine& e) {
+        auto& state = State(e.grid);
+        int width = LineWidth(e);
+        if (state.replaced) {
+          drop = true;
+          stats.droppedCells += width;
+          return;
+        }
+        if (e.row < 0 || width == 0) return;
+        if (size_t(e.row) >= state.covered.size()) state.covered.resize(e.row + 1);
+        auto& spans = state.covered[e.row];
+
+        int start = e.colStart;
+        int end = start + width;
+        int keepStart = start;
+        int keepEnd = end;
+        for (auto [first, second] : spans) {
+          if (first <= start && start < second) keepStart = second;
+          if (first < end && end <= second) keepEnd = first;
+        }
+        if (keepStart >= keepEnd) {
+          drop = true;
+          stats.droppedCells += width;
+          return;
+        }
+        if (keepStart != start || keepEnd != end) {
+          stats.droppedCells += TrimLine(e, keepStart, keepEnd, arena);
+        }
+        AddSpan(spans, {start, end});
+      },
+      [&](GridClear& e) {
+        auto& state = State(e.grid);
+        drop = state.replaced;
+        state.replaced = true;
+      },
+      [&](GridScroll& e) {
+        auto& state = State(e.grid);
+        drop = state.replaced;
+        // cells move, later lines don't hide earlier ones across it
+        for (auto& spans : state.covered) spans.clear();
+      },
+      [&](GridDestroy& e) {
+        State(e.grid).replaced = true;
+      },
+      // resize keeps cells in place, cursor doesn't touch cells
+      [&](auto&) {},
+    }, *event);
+
+    if (drop) {
+      stats.droppedEvents++;
+      event = nullptr;
+    }
+  }
+}
+
+// cells after a clear are blank, so blank cells written to them can go
+void GridEventCompactor::Forward(
+  std::vector<UiEvent*>& gridEvents, Arena& arena, Stats& stats
+) {
+  for (auto& [_, state] : grids) {
+    state.cleared = false;
+    std::ranges::fill(state.touched, Span{});
+  }
+
+  for (auto*& event : gridEvents) {
+    bool drop = false;
+
+    std::visit(overloaded{
+      [&](GridLine& e) {
+        auto& state = State(e.grid);
+        if (!state.cleared || e.row < 0) return;
+        if (size_t(e.row) >= state.touched.size()) state.touched.resize(e.row + 1);
+        auto& touched = state.touched[e.row];
+
+        // start of the trailing blank run, blank as left by GridManager::Clear
+        int col = e.colStart;
+        int recentHlId = 0;
+        int blankStart = -1;
+        for (const auto& cell : e.cells) {
+          if (cell.hlId) recentHlId = *cell.hlId;
+          bool blank = cell.text == " " && recentHlId == 0;
+          if (!blank) {
+            blankStart = -1;
+          } else if (blankStart == -1) {
+            blankStart = col;
+          }
+          col += cell.repeat ? *cell.repeat : 1;
+        }
+        int end = col;
+
+        int keepEnd = blankStart == -1 ? end : blankStart;
+        // columns written since the clear aren't blank anymore
+        if (touched.first < touched.second && touched.first < end) {
+          keepEnd = std::min(end, std::max(keepEnd, touched.second));
+        }
+
+        if (keepEnd <= e.colStart) {
+          drop = true;
+          stats.droppedCells += end - e.colStart;
+          return;
+        }
+        if (keepEnd != end) {
+          stats.droppedCells += TrimLine(e, e.colStart, keepEnd, arena);
+        }
+        touched = touched.first < touched.second
+                    ? Span{std::min(touched.first, e.colStart), std::max(touched.second, keepEnd)}
+                    : Span{e.colStart, keepEnd};
+      },
+      [&](GridClear& e) {
+        auto& state = State(e.grid);
+        state.cleared = true;
+        std::ranges::fill(state.touched, Span{});
+      },
+      [&](GridScroll& e) {
+        State(e.grid).cleared = false;
+      },
+      [&](GridDestroy& e) {
+        State(e.grid).cleared = false;
+      },
+      // resized in cells are blank too
+      [&](auto&) {},
+    }, *event);
+
+    if (drop) {
+      stats.droppedEvents++;
+      event = nullptr;
+    }
+  }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "event/ui_parse.hpp"
+#include "utils/arena.hpp"
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Removes grid work of a flush that can't be seen once the flush is applied:
+// - grid_line cells overwritten by a later grid_line of the same flush
+//   (whole events are dropped, partly covered ones are trimmed)
+// - grid_line, grid_scroll and grid_clear before a grid_clear or grid_destroy
+// - blank cells written right after a grid_clear, they're already blank
+// Applying the compacted events leaves the grids exactly as the original ones.
+// Trimmed cells are reallocated in the batch's arena.
+class GridEventCompactor {
+public:
+  struct Stats {
+    size_t droppedEvents = 0;
+    // grid cells that are no longer written
+    size_t droppedCells = 0;
+  };
+
+  // gridEvents are one flush's grid events in order, dropped ones are removed
+  Stats Compact(std::vector<UiEvent*>& gridEvents, Arena& arena);
+
+private:
+  using Span = std::pair<int, int>; // columns [first, second)
+
+  struct GridState {
+    // a later clear or destroy replaces every cell (backward pass)
+    bool replaced;
+    // every cell is blank since a clear, except touched ones (forward pass)
+    bool cleared;
+    // backward pass: columns written by later lines, sorted and merged
+    std::vector<std::vector<Span>> covered;
+    // forward pass: hull of columns written since the clear
+    std::vector<Span> touched;
+  };
+  // kept across flushes so they stop allocating
+  std::unordered_map<int, GridState> grids;
+
+  GridState& State(int grid);
+  void Backward(std::vector<UiEvent*>& gridEvents, Arena& arena, Stats& stats);
+  void Forward(std::vector<UiEvent*>& gridEvents, Arena& arena, Stats& stats);
+};
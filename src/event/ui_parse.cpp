@@ -1,182 +1,405 @@
 #include "./ui_parse.hpp"
+#include "nvim/msgpack_rpc/reader.hpp"
 #include "utils/logger.hpp"
+#include "utils/trace.hpp"
 #include "session/manager.hpp"
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <span>
 
 using namespace event;
 
+// args of a single event call, reader is positioned at its array
+struct UiEventArgs {
+  rpc::Reader& reader;
+  msgpack::zone& zone;
+
+  // cold path, unpacks into the notification's zone
+  msgpack::object Object() {
+    return reader.ReadObject(zone);
+  }
+  template <typename T>
+  T As() {
+    return Object().as<T>();
+  }
+
+  void Skip() {
+    reader.Skip();
+  }
+  int Int() {
+    return reader.ReadInt();
+  }
+
+  // array header of the args, throws if there are less than minSize fields
+  uint32_t Array(uint32_t minSize) {
+    uint32_t size = reader.ReadArray();
+    if (size < minSize) throw msgpack::type_error();
+    return size;
+  }
+  // skips fields added by newer nvim versions
+  void SkipExtra(uint32_t size, uint32_t numRead) {
+    for (uint32_t i = numRead; i < size; i++) reader.Skip();
+  }
+};
+
+// rgb_attr map of hl_attr_define, keys are told apart by length first
+static void ReadHlAttrs(rpc::Reader& reader, Arena& arena, HlAttrs& attrs) {
+  uint32_t size = reader.ReadMap();
+  for (uint32_t i = 0; i < size; i++) {
+    std::string_view key = reader.ReadStr();
+    switch (key.size()) {
+      case 3:
+        if (key == "url") {
+          attrs.url = arena.Copy(reader.ReadStr());
+          continue;
+        }
+        break;
+      case 4:
+        if (key == "bold") {
+          attrs.bold = reader.ReadBool();
+          continue;
+        }
+        break;
+      case 5:
+        if (key == "blend") {
+          attrs.blend = reader.ReadInt();
+          continue;
+        }
+        break;
+      case 6:
+        if (key == "italic") {
+          attrs.italic = reader.ReadBool();
+          continue;
+        }
+        break;
+      case 7:
+        if (key == "reverse") {
+          attrs.reverse = reader.ReadBool();
+          continue;
+        }
+        if (key == "special") {
+          attrs.special = reader.ReadInt();
+          continue;
+        }
+        break;
+      case 9:
+        if (key == "underline" || key == "undercurl") {
+          bool set = reader.ReadBool();
+          if (set) {
+            attrs.underline =
+              key[5] == 'l' ? UnderlineType::Underline : UnderlineType::Undercurl;
+          }
+          continue;
+        }
+        break;
+      case 10:
+        if (key == "foreground") {
+          attrs.foreground = reader.ReadInt();
+          continue;
+        }
+        if (key == "background") {
+          attrs.background = reader.ReadInt();
+          continue;
+        }
+        break;
+      case 11:
+        if (key == "underdouble" || key == "underdotted" || key == "underdashed") {
+          bool set = reader.ReadBool();
+          if (set) {
+            attrs.underline = key[7] == 'u'   ? UnderlineType::Underdouble
+                              : key[7] == 't' ? UnderlineType::Underdotted
+                                              : UnderlineType::Underdashed;
+          }
+          continue;
+        }
+        break;
+      case 13:
+        if (key == "strikethrough") {
+          attrs.strikethrough = reader.ReadBool();
+          continue;
+        }
+        break;
+    }
+    // nocombine, altfont, standout, ...
+    reader.Skip();
+  }
+}
+
 // clang-format off
-using UiEventFunc = void (*)(const msgpack::object& args, UiEvents& uiEvents);
-static const std::unordered_map<std::string_view, UiEventFunc> uiEventFuncs = {
+using UiEventFunc = void (*)(UiEventArgs& args, UiEvents& uiEvents);
+struct UiEventEntry {
+  std::string_view name;
+  UiEventFunc func;
+};
+static constexpr UiEventEntry uiEventFuncs[] = {
   // Global Events ----------------------------------------------------------
-  {"set_title", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<SetTitle>());
+  {"set_title", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<SetTitle>());
   }},
 
-  {"set_icon", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<SetIcon>());
+  {"set_icon", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<SetIcon>());
   }},
 
-  {"mode_info_set", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<ModeInfoSet>());
+  {"mode_info_set", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<ModeInfoSet>());
   }},
 
-  {"option_set", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG_INFO("option_set: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<OptionSet>());
+  {"option_set", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<OptionSet>());
   }},
 
-  {"chdir", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<Chdir>());
+  {"chdir", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<Chdir>());
   }},
 
-  {"mode_change", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<ModeChange>());
+  {"mode_change", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<ModeChange>());
   }},
 
-  {"mouse_on", [](const msgpack::object&, UiEvents& uiEvents) {
+  {"mouse_on", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(MouseOn{});
   }},
 
-  {"mouse_off", [](const msgpack::object&, UiEvents& uiEvents) {
+  {"mouse_off", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(MouseOff{});
   }},
 
-  {"busy_start", [](const msgpack::object&, UiEvents& uiEvents) {
+  {"busy_start", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(BusyStart{});
   }},
 
-  {"busy_stop", [](const msgpack::object&, UiEvents& uiEvents) {
+  {"busy_stop", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(BusyStop{});
   }},
 
-  {"update_menu", [](const msgpack::object&, UiEvents& uiEvents) {
+  {"update_menu", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(UpdateMenu{});
   }},
 
-  {"flush", [](const msgpack::object&, UiEvents& uiEvents) {
-    static int i = 0;
-    LOG("flush {} ---------------------------- ", i++);
+  {"flush", [](UiEventArgs& args, UiEvents& uiEvents) {
+    args.Skip();
     uiEvents.Curr().emplace_back(Flush{});
-    uiEvents.queue.emplace_back();
-    uiEvents.numFlushes++;
+    uiEvents.Flush();
   }},
 
-  {"default_colors_set", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG_INFO("default_colors_set: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<DefaultColorsSet>());
+  {"default_colors_set", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<DefaultColorsSet>());
   }},
 
-  {"hl_attr_define", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG_INFO("hl_attr_define: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<HlAttrDefine>());
+  // colorscheme loads send thousands of these at once
+  {"hl_attr_define", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uint32_t size = args.Array(2);
+    HlAttrDefine e{.id = args.Int()};
+    ReadHlAttrs(args.reader, uiEvents.CurrArena(), e.rgbAttrs);
+    // cterm_attr, info
+    args.SkipExtra(size, 2);
+    uiEvents.Curr().emplace_back(e);
   }},
 
-  {"hl_group_set", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG_INFO("hl_group_set: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<HlGroupSet>());
+  {"hl_group_set", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<HlGroupSet>());
   }},
 
   // Grid Events --------------------------------------------------------------
-  {"grid_resize", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("grid_resize: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<GridResize>());
+  {"grid_resize", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<GridResize>());
   }},
 
-  {"grid_clear", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("grid_clear: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<GridClear>());
+  {"grid_clear", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<GridClear>());
   }},
 
-  {"grid_cursor_goto", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<GridCursorGoto>());
+  // hot events below are decoded straight from the bytes
+  {"grid_cursor_goto", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uint32_t size = args.Array(3);
+    // braced init evaluates in order
+    GridCursorGoto e{.grid = args.Int(), .row = args.Int(), .col = args.Int()};
+    args.SkipExtra(size, 3);
+    uiEvents.Curr().emplace_back(e);
   }},
 
-  {"grid_line", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<GridLine>());
+  {"grid_line", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uint32_t size = args.Array(4);
+    GridLine e;
+    e.grid = args.Int();
+    e.row = args.Int();
+    e.colStart = args.Int();
+
+    auto& arena = uiEvents.CurrArena();
+    auto cells = arena.MakeArray<GridLine::Cell>(args.reader.ReadArray());
+    for (auto& cell : cells) {
+      uint32_t cellSize = args.reader.ReadArray();
+      if (cellSize == 0) throw msgpack::type_error();
+      cell.text = arena.Copy(args.reader.ReadStr());
+      if (cellSize > 1) cell.hlId = args.Int();
+      if (cellSize > 2) cell.repeat = args.Int();
+      args.SkipExtra(cellSize, 3);
+    }
+    e.cells = cells;
+
+    e.wrap = size > 4 && args.reader.ReadBool();
+    args.SkipExtra(size, 5);
+    uiEvents.Curr().emplace_back(std::move(e));
   }},
 
-  {"grid_scroll", [](const msgpack::object& args, UiEvents& uiEvents) {
-    uiEvents.Curr().emplace_back(args.as<GridScroll>());
+  {"grid_scroll", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uint32_t size = args.Array(7);
+    GridScroll e{
+      .grid = args.Int(),
+      .top = args.Int(),
+      .bot = args.Int(),
+      .left = args.Int(),
+      .right = args.Int(),
+      .rows = args.Int(),
+      .cols = args.Int(),
+    };
+    args.SkipExtra(size, 7);
+    uiEvents.Curr().emplace_back(e);
   }},
 
-  {"grid_destroy", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("grid_destroy: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<GridDestroy>());
+  {"grid_destroy", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<GridDestroy>());
   }},
 
   // Multigrid Events ------------------------------------------------------------
-  {"win_pos", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("win_pos: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinPos>());
+  {"win_pos", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinPos>());
   }},
 
-  {"win_float_pos", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("win_float_pos: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinFloatPos>());
+  {"win_float_pos", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinFloatPos>());
   }},
 
-  {"win_external_pos", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG("win_external_pos: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinExternalPos>());
+  {"win_external_pos", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinExternalPos>());
   }},
 
-  {"win_hide", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("win_hide: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinHide>());
+  {"win_hide", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinHide>());
   }},
 
-  {"win_close", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("win_close: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinClose>());
+  {"win_close", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinClose>());
   }},
 
-  {"msg_set_pos", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("msg_set_pos: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<MsgSetPos>());
+  {"msg_set_pos", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<MsgSetPos>());
   }},
 
-  {"win_viewport", [](const msgpack::object& args, UiEvents& uiEvents) {
-    LOG("win_viewport: {}", ToString(args));
-    // LOG_INFO("win_viewport: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinViewport>());
+  {"win_viewport", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinViewport>());
   }},
 
-  {"win_viewport_margins", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG("win_viewport_margins: {}", ToString(args));
-    // LOG_INFO("win_viewport_margins: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinViewportMargins>());
+  {"win_viewport_margins", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinViewportMargins>());
   }},
 
-  {"win_extmark", [](const msgpack::object& args, UiEvents& uiEvents) {
-    // LOG("win_extmark: {}", ToString(args));
-    uiEvents.Curr().emplace_back(args.as<WinExtmark>());
+  {"win_extmark", [](UiEventArgs& args, UiEvents& uiEvents) {
+    uiEvents.Curr().emplace_back(args.As<WinExtmark>());
   }},
 };
 // clang-format on
 
-void ParseUiRedraw(const msgpack::object& params, UiEvents& uiEvents) {
-  std::span<const msgpack::object> events = params.via.array;
-
-  for (const msgpack::object& eventObj : events) {
-    std::span<const msgpack::object> args = eventObj.via.array;
-    std::string_view eventName = args[0].convert();
-    auto eventArgs = args.subspan(1);
+// Perfect hash over the names above, the seed is searched at compile time so
+// every event gets its own slot. Mixes the length and the first, middle and
+// last chars, which already tell all event names apart.
+static constexpr int uiEventHashBits = 7;
+
+static constexpr size_t UiEventHash(std::string_view name, uint64_t seed) {
+  constexpr uint64_t k = 0x9e3779b97f4a7c15;
+  uint64_t x = (seed ^ name.size()) * k;
+  x = (x ^ uint8_t(name[0])) * k;
+  x = (x ^ uint8_t(name[name.size() / 2])) * k;
+  x = (x ^ uint8_t(name.back())) * k;
+  return x >> (64 - uiEventHashBits);
+}
 
-    auto it = uiEventFuncs.find(eventName);
-    if (it == uiEventFuncs.end()) {
-      LOG_WARN("Unknown event: {}", eventName);
-      continue;
+static consteval uint64_t FindUiEventSeed() {
+  for (uint64_t seed = 0; seed < 10000; seed++) {
+    std::array<bool, 1 << uiEventHashBits> used{};
+    bool collision = false;
+    for (const auto& entry : uiEventFuncs) {
+      auto& slot = used[UiEventHash(entry.name, seed)];
+      collision |= slot;
+      slot = true;
     }
-    auto uiEventFunc = it->second;
+    if (!collision) return seed;
+  }
+  throw "no perfect hash seed found, increase uiEventHashBits";
+}
+static constexpr uint64_t uiEventSeed = FindUiEventSeed();
+
+// index into uiEventFuncs by hash, -1 if empty
+static constexpr auto uiEventSlots = [] {
+  std::array<int8_t, 1 << uiEventHashBits> slots;
+  slots.fill(-1);
+  for (size_t i = 0; i < std::size(uiEventFuncs); i++) {
+    slots[UiEventHash(uiEventFuncs[i].name, uiEventSeed)] = i;
+  }
+  return slots;
+}();
+
+int UiEventIndex(std::string_view name) {
+  if (name.empty()) return -1;
+  int index = uiEventSlots[UiEventHash(name, uiEventSeed)];
+  if (index < 0 || uiEventFuncs[index].name != name) return -1;
+  return index;
+}
 
-    for (const msgpack::object& arg : eventArgs) {
-      try {
-        uiEventFunc(arg, uiEvents);
-      } catch (const msgpack::type_error& e) {
-        LOG_ERR("ParseUiEvents: {}", e.what());
+std::vector<std::string_view> UiEventNames() {
+  std::vector<std::string_view> names;
+  for (const auto& entry : uiEventFuncs) names.push_back(entry.name);
+  return names;
+}
+
+void ParseUiRedraw(
+  std::span<const char> params, rpc::PooledZone zone, UiEvents& uiEvents
+) {
+  TRACE_SCOPE("parse_redraw");
+  rpc::Reader reader(params);
+  UiEventArgs args{reader, *zone};
+
+  try {
+    uint32_t numEvents = reader.ReadArray();
+    for (uint32_t i = 0; i < numEvents; i++) {
+      uint32_t numArgs = reader.ReadArray();
+      if (numArgs == 0) continue;
+      std::string_view eventName = reader.ReadStr();
+
+      int index = UiEventIndex(eventName);
+      if (index < 0) {
+        // only the first is logged, the rest show up in the stats
+        if (uiEvents.unknownEvents.fetch_add(1, std::memory_order_relaxed) == 0) {
+          LOG_WARN("ParseUiRedraw: unknown event {}", eventName);
+        }
+        args.SkipExtra(numArgs, 1);
+        continue;
+      }
+      auto uiEventFunc = uiEventFuncs[index].func;
+
+      for (uint32_t j = 1; j < numArgs; j++) {
+        rpc::Reader argStart = reader;
+        try {
+          uiEventFunc(args, uiEvents);
+        } catch (const msgpack::type_error& e) {
+          LOG_ERR("ParseUiEvents: {}", e.what());
+          reader = argStart;
+          reader.Skip();
+        }
       }
     }
+  } catch (const msgpack::type_error& e) {
+    LOG_ERR("ParseUiRedraw: malformed redraw - {}", e.what());
+  } catch (const msgpack::unpack_error& e) {
+    LOG_ERR("ParseUiRedraw: malformed redraw - {}", e.what());
   }
+
+  // events own what they need or have it copied into the batch's arena,
+  // so the zone goes back to the pool here
 }
@@ -2,6 +2,25 @@
 
 #include <type_traits>
 #include "msgpack.hpp"
+#include "nvim/api_types.hpp"
+#include "nvim/msgpack_rpc/pool.hpp"
+#include "utils/arena.hpp"
+#include "utils/thread.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+enum class UnderlineType : uint32_t {
+  Underline,
+  Undercurl,
+  Underdouble,
+  Underdotted,
+  Underdashed,
+};
 
 namespace event {
 
@@ -47,13 +66,27 @@ struct DefaultColorsSet {
   uint32_t ctermBg;
   MSGPACK_DEFINE(rgbFg, rgbBg, rgbSp, ctermFg, ctermBg);
 };
+// highlight attributes as sent by nvim_get_hl
 using HlAttrMap = std::map<std::string, msgpack::type::variant>;
+// rgb_attr of hl_attr_define, decoded straight from the bytes.
+// Colors are 0xRRGGBB, unset ones are taken from the default highlight.
+struct HlAttrs {
+  std::optional<uint32_t> foreground;
+  std::optional<uint32_t> background;
+  std::optional<uint32_t> special;
+  bool reverse = false;
+  bool italic = false;
+  bool bold = false;
+  bool strikethrough = false;
+  std::optional<UnderlineType> underline;
+  int blend = 0; // 0 - 100
+  // points into the batch's arena
+  std::string_view url;
+};
+// cterm_attr and info (ext_hlstate) aren't used, the parser skips them
 struct HlAttrDefine {
   int id;
-  HlAttrMap rgbAttrs;
-  HlAttrMap ctermAttrs;
-  std::vector<HlAttrMap> info;
-  MSGPACK_DEFINE(id, rgbAttrs, ctermAttrs, info);
+  HlAttrs rgbAttrs;
 };
 struct HlGroupSet {
   std::string name;
@@ -78,17 +111,17 @@ struct GridCursorGoto {
 };
 struct GridLine {
   struct Cell {
-    std::string text;
+    // points into the batch's arena (UiEventBatch::arena)
+    std::string_view text;
     std::optional<int> hlId;
     std::optional<int> repeat;
-    MSGPACK_DEFINE(text, hlId, repeat);
   };
   int grid;
   int row;
   int colStart;
-  std::vector<Cell> cells;
+  // allocated in the batch's arena
+  std::span<const Cell> cells;
   bool wrap;
-  MSGPACK_DEFINE(grid, row, colStart, cells, wrap);
 };
 struct GridScroll {
   int grid;
@@ -106,7 +139,7 @@ struct GridDestroy {
 };
 struct WinPos {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   int startRow;
   int startCol;
   int width;
@@ -115,7 +148,7 @@ struct WinPos {
 };
 struct WinFloatPos {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   std::string anchor;
   int anchorGrid;
   float anchorRow;
@@ -141,7 +174,7 @@ struct WinFloatPos {
 };
 struct WinExternalPos {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   MSGPACK_DEFINE(grid, win);
 };
 struct WinHide {
@@ -163,7 +196,7 @@ struct MsgSetPos {
 };
 struct WinViewport {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   int topline;
   int botline;
   int curline;
@@ -174,7 +207,7 @@ struct WinViewport {
 };
 struct WinViewportMargins {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   int top;
   int bottom;
   int left;
@@ -183,7 +216,7 @@ struct WinViewportMargins {
 };
 struct WinExtmark {
   int grid;
-  msgpack::type::ext win;
+  api::Handle win;
   int nsId;
   int markId;
   int row;
@@ -225,17 +258,96 @@ using UiEvent = std::variant<
   event::WinViewportMargins,
   event::WinExtmark>;
 
+// hot events hold no heap memory, clearing a recycled batch is free for them
+static_assert(std::is_trivially_destructible_v<event::GridLine>);
+static_assert(std::is_trivially_destructible_v<event::GridCursorGoto>);
+static_assert(std::is_trivially_destructible_v<event::GridScroll>);
+static_assert(std::is_trivially_destructible_v<event::WinViewport>);
+static_assert(std::is_trivially_destructible_v<event::HlAttrDefine>);
+
+// events between two flushes. Hot events are trivially destructible and
+// their variable sized data (grid_line cells and text) lives in the arena.
+// Batches are recycled with their capacity, so steady state redraws don't
+// allocate.
+struct UiEventBatch {
+  std::vector<UiEvent> events;
+  Arena arena;
+
+  void Clear() {
+    events.clear();
+    arena.Reset();
+  }
+};
+
+// Redraw events, parsed on the rpc reader thread into flush-complete batches
+// that the render thread takes as a whole.
 struct UiEvents {
+  // parser side ------------------------------
+  // events since the last flush
+  UiEventBatch curr;
+  // redraw events without a handler, read by SessionManager::Stats
+  std::atomic_size_t unknownEvents = 0;
+
+  auto& Curr() {
+    return curr.events;
+  }
+  Arena& CurrArena() {
+    return curr.arena;
+  }
+
+  // hands curr over to the render thread, continues with a recycled batch
+  void Flush() {
+    UiEventBatch next;
+    {
+      auto access = spare.lock();
+      if (!access->empty()) {
+        next = std::move(access->back());
+        access->pop_back();
+      }
+    }
+    ready.lock()->push_back(std::move(curr));
+    curr = std::move(next);
+  }
+
+  // render side ------------------------------
+  // batches taken by the last TakeReady(), in order
+  std::vector<UiEventBatch> queue;
   int numFlushes = 0;
-  std::deque<std::deque<UiEvent>> queue;
 
-  UiEvents() {
-    queue.emplace_back();
+  void TakeReady() {
+    {
+      auto access = ready.lock();
+      std::ranges::move(*access, std::back_inserter(queue));
+      access->clear();
+    }
+    numFlushes = queue.size();
   }
 
-  auto& Curr() {
-    return queue.back();
+  // call once the events in queue are processed, hands the batches back to
+  // the parser
+  void Recycle() {
+    auto access = spare.lock();
+    for (auto& batch : queue) {
+      if (access->size() >= maxSpare) break;
+      batch.Clear();
+      access->push_back(std::move(batch));
+    }
+    queue.clear();
   }
+
+private:
+  // a few are enough, the render thread takes all ready batches every frame
+  static constexpr size_t maxSpare = 4;
+  Sync<std::vector<UiEventBatch>> ready;
+  Sync<std::vector<UiEventBatch>> spare;
 };
 
-void ParseUiRedraw(const msgpack::object& params, UiEvents& events);
+// params are the raw msgpack bytes of the redraw notification, allocated in zone
+void ParseUiRedraw(
+  std::span<const char> params, rpc::PooledZone zone, UiEvents& events
+);
+
+// index of a redraw event in the parser's dispatch table, -1 if it has no handler
+int UiEventIndex(std::string_view name);
+// names of all handled redraw events, in dispatch table order
+std::vector<std::string_view> UiEventNames();
@@ -1,8 +1,9 @@
 #include "./ui_process.hpp"
+#include "./ui_compact.hpp"
 #include "glm/gtx/string_cast.hpp"
 #include "session/state.hpp"
 #include "utils/logger.hpp"
-#include <deque>
+#include "utils/trace.hpp"
 #include <utility>
 #include <vector>
 #include "utils/variant.hpp"
@@ -42,23 +43,29 @@ static const auto winTypes = vIndicesSet<
 // clang-format off
 // i don't like clang format on std::visit(overloaded{})
 void ProcessUiEvents(SessionHandle& session) {
+  TRACE_SCOPE("process_ui_events");
   auto& editorState = session->editorState;
-  auto& uiEvents = session->uiEvents;
+  auto& uiEvents = *session->uiEvents;
 
-  for (int i = 0; i < uiEvents.numFlushes; i++) {
-    assert(!uiEvents.queue.empty());
-    std::deque<UiEvent> redrawEvents = std::move(uiEvents.queue.front());
-    uiEvents.queue.pop_front();
+  // kept across flushes (only the main thread processes events),
+  // so they stop allocating once grown
+  // don't need this, since win events are executed last,
+  // but just for organization/future refactoring
+  static std::vector<UiEvent*> gridEvents;
+  // occasionally win events are sent before grid events
+  // so just handle manually
+  static std::vector<UiEvent*> winEvents;
+  // neovim sends these events before appropriate window is created
+  static std::vector<WinViewportMargins*> margins;
+  static std::vector<MsgSetPos*> msgSetPos;
+  static GridEventCompactor compactor;
 
-    // don't need this, since win events are executed last,
-    // but just for organization/future refactoring
-    std::vector<UiEvent*> gridEvents;
-    // occasionally win events are sent before grid events
-    // so just handle manually
-    std::vector<UiEvent*> winEvents;
-    // neovim sends these events before appropriate window is created
-    std::vector<WinViewportMargins*> margins;
-    std::vector<MsgSetPos*> msgSetPos;
+  for (auto& batch : uiEvents.queue) {
+    auto& redrawEvents = batch.events;
+    gridEvents.clear();
+    winEvents.clear();
+    margins.clear();
+    msgSetPos.clear();
 
     for (UiEvent& event : redrawEvents) {
       std::visit(overloaded{
@@ -116,14 +123,17 @@ void ProcessUiEvents(SessionHandle& session) {
           // own elements with consistent highlighting
         },
         [&](MsgSetPos& e) {
-          LOG("MsgSetPos: {}", e.grid);
+          TRACE_INSTANT("msg_set_pos", e.grid);
           msgSetPos.push_back(&e);
         },
         [&](WinViewportMargins& e) {
-          LOG("WinViewportMargins: {}", e.grid);
+          TRACE_INSTANT("win_viewport_margins", e.grid);
           margins.push_back(&e);
         },
         [&](Flush&) {
+          // drop cells overwritten within the flush
+          compactor.Compact(gridEvents, batch.arena);
+
           // execute grid events before win events
           for (auto *event : gridEvents) {
             std::visit(overloaded{
@@ -141,6 +151,10 @@ void ProcessUiEvents(SessionHandle& session) {
               },
               [&](GridClear& e) {
                 editorState.gridManager.Clear(e);
+                // blank lines after a clear are compacted away
+                if (e.grid == editorState.cursor.grid) {
+                  editorState.cursor.dirty = true;
+                }
               },
               [&](GridCursorGoto& e) {
                 editorState.cursor.Goto(e);
@@ -221,5 +235,6 @@ void ProcessUiEvents(SessionHandle& session) {
       }, event);
     }
   }
+  uiEvents.Recycle();
 }
 // clang-format on
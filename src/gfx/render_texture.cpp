@@ -7,6 +7,8 @@
 #include "glm/common.hpp"
 #include "utils/line.hpp"
 #include "utils/easing_funcs.hpp"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
 
@@ -122,6 +124,7 @@ void ScrollableRenderTexture::UpdateViewport(float newScrollDist) {
   scrolling = true;
   scrollCurr = 0;
   scrollElapsed = 0;
+  scrolledRows += std::round(newScrollDist / charSize.y);
 
   AddOrRemoveTextures();
   SetTextureCameraPositions();
@@ -183,6 +186,10 @@ void ScrollableRenderTexture::UpdateMargins(const Margins& _margins) {
 
   auto oldFmargins = fmargins;
   fmargins = margins.ToFloat(charSize);
+  // rows move between the margin and inner textures
+  if (fmargins.top != oldFmargins.top || fmargins.bottom != oldFmargins.bottom) {
+    damaged = true;
+  }
 
   if (fmargins.top != 0) {
     if (marginTextures.top == nullptr || fmargins.top != oldFmargins.top) {
@@ -229,6 +236,8 @@ void ScrollableRenderTexture::AddOrRemoveTextures() {
 
   renderTextures.erase(renderTextures.begin(), renderTextures.begin() + numRemoved);
   region.pos -= numRemoved * textureHeight;
+  renderedStart = std::max(renderedStart - numRemoved * rowsPerTexture, 0);
+  renderedEnd -= numRemoved * rowsPerTexture;
 
   // remove from the bottom
   numRemoved = 0;
@@ -241,6 +250,7 @@ void ScrollableRenderTexture::AddOrRemoveTextures() {
     numRemoved++;
   }
   renderTextures.erase(renderTextures.end() - numRemoved, renderTextures.end());
+  renderedEnd = std::min(renderedEnd, int(renderTextures.size()) * rowsPerTexture);
 
   auto createTexture = [&removed, this]() {
     if (!removed.empty()) {
@@ -266,6 +276,8 @@ void ScrollableRenderTexture::AddOrRemoveTextures() {
     numAdded++;
   }
   region.pos += textureHeight * numAdded;
+  renderedStart += numAdded * rowsPerTexture;
+  renderedEnd += numAdded * rowsPerTexture;
 
   // add from bottom
   for (size_t i = renderTextures.size();; i++) {
@@ -328,18 +340,40 @@ void ScrollableRenderTexture::SetTextureCameraPositions() {
   }
 }
 
-std::vector<RenderInfo> ScrollableRenderTexture::GetRenderInfos(int maxRows) const {
-  // top of viewport after scrolling
+int ScrollableRenderTexture::TopRow() const {
+  // top of viewport after scrolling, always a whole number of rows
   float newBaseOffset = baseOffset + scrollDist;
   newBaseOffset = RoundToPixel(newBaseOffset, dpiScale);
+  return std::round(newBaseOffset / charSize.y);
+}
 
-  int topOffset = newBaseOffset / charSize.y;
-  int bottomOffset = (newBaseOffset + size.y) / charSize.y;
+bool ScrollableRenderTexture::IsInnerRow(int row) const {
+  int totalRows = size.y / charSize.y;
+  return row >= margins.top && row < totalRows - margins.bottom;
+}
 
-  int innerTopOffset = topOffset + margins.top;
-  int innerBottomOffset = bottomOffset - margins.bottom;
+bool ScrollableRenderTexture::IsRendered(int row) const {
+  int textureRow = TopRow() + row;
+  return textureRow >= renderedStart && textureRow < renderedEnd;
+}
 
+void ScrollableRenderTexture::SetRendered(int maxRows) {
   int totalRows = size.y / charSize.y;
+  int topRow = TopRow();
+  renderedStart = topRow + margins.top;
+  renderedEnd = topRow + std::min(totalRows - margins.bottom, maxRows);
+  scrolledRows = 0;
+  damaged = false;
+}
+
+std::vector<RenderInfo> ScrollableRenderTexture::GetRenderInfos(int maxRows) const {
+  int totalRows = size.y / charSize.y;
+
+  int topOffset = TopRow();
+  int bottomOffset = topOffset + totalRows;
+
+  int innerTopOffset = topOffset + margins.top;
+  int innerBottomOffset = bottomOffset - margins.bottom;
 
   std::vector<RenderInfo> renderInfos;
 
@@ -90,9 +90,20 @@ struct ScrollableRenderTexture {
   // PD scroll
   Spring spring;
 
-  QuadRenderData<RectQuadVertex> clearData;
+  // one per cleared region, written once before the render passes
+  QuadRenderData<RectQuadVertex, true> clearData;
 
   mutable bool first = true; // make sure render all to all texture when first created
+  // rows no longer line up with the rendered content (new textures or
+  // margins changed), the next render redraws every row
+  bool damaged = true;
+
+  // texture rows (texture i holds [i * rowsPerTexture, (i + 1) * rowsPerTexture))
+  // with rendered content, they stay valid as the viewport scrolls over them
+  int renderedStart = 0;
+  int renderedEnd = 0;
+  // rows the viewport scrolled since the last render
+  int scrolledRows = 0;
 
   ScrollableRenderTexture() = default;
   ScrollableRenderTexture(
@@ -104,6 +115,15 @@ struct ScrollableRenderTexture {
   void UpdateScrolling(std::span<float> steps);
   void UpdateMargins(const Margins& margins);
 
+  // texture row of grid row 0 after scrolling
+  int TopRow() const;
+  // grid row is outside the margins, so it scrolls with the viewport
+  bool IsInnerRow(int row) const;
+  // inner grid row already has its content in a texture
+  bool IsRendered(int row) const;
+  // call after rendering every row up to maxRows that isn't IsRendered
+  void SetRendered(int maxRows);
+
   void AddOrRemoveTextures();
   void SetTexturePositions();
   void SetTextureCameraPositions();
@@ -5,6 +5,7 @@
 #include "gfx/instance.hpp"
 #include "gfx/pipeline.hpp"
 #include "utils/logger.hpp"
+#include "utils/trace.hpp"
 #include "utils/region.hpp"
 #include "utils/color.hpp"
 #include "utils/unicode.hpp"
@@ -177,6 +178,7 @@ void Renderer::Begin() {
 }
 
 void Renderer::RenderToWindow(Win& win, FontFamily& fontFamily, HlManager& hlManager) {
+  TRACE_SCOPE("render_to_window");
   // if for whatever reason (prob nvim events buggy, events not sent or offsync)
   // the grid is not the same size as the window
   if (win.grid.width != win.width || win.grid.height != win.height) {
@@ -189,10 +191,35 @@ void Renderer::RenderToWindow(Win& win, FontFamily& fontFamily, HlManager& hlMan
     // );
   }
 
-textureReset:
-  // keep track of quad index after each row
   size_t rows = std::min(win.grid.height, win.height);
   size_t cols = std::min(win.grid.width, win.width);
+
+  // only damaged rows are rebuilt and rendered, unless the textures don't
+  // line up with the rows anymore
+  auto& sRenderTexture = win.sRenderTexture;
+  const auto& damage = win.grid.damage;
+  const bool renderAll = sRenderTexture.damaged;
+  auto renderInfos = sRenderTexture.GetRenderInfos(rows);
+
+  renderRows.Resize(rows);
+  if (!renderAll) {
+    renderRows.Clear();
+    // a viewport scroll moves the rendered rows along with the textures, so
+    // rows that grid_scroll moved by the same amount are already in place and
+    // only the exposed ones are rendered. margin rows don't scroll.
+    for (int row = 0; row < int(rows); row++) {
+      bool inner = sRenderTexture.IsInnerRow(row);
+      int viewportScrolled = inner ? sRenderTexture.scrolledRows : 0;
+      bool inPlace = damage.IsMoved(row) ? damage.Scrolled() == viewportScrolled
+                                         : viewportScrolled == 0;
+      if (damage.IsChanged(row) || !inPlace || (inner && !sRenderTexture.IsRendered(row))) {
+        renderRows.Add(row, row + 1);
+      }
+    }
+  }
+
+textureReset:
+  // keep track of quad index after each row
   std::vector<int> rectIntervals; rectIntervals.reserve(rows + 1);
   std::vector<int> textIntervals; textIntervals.reserve(rows + 1);
   std::vector<int> emojiIntervals; emojiIntervals.reserve(rows + 1);
@@ -230,7 +257,7 @@ textureReset:
     }
   } run;
 
-  auto addTextGlyph = [&](const GlyphInfo& glyphInfo, glm::vec2 offset, const Highlight& hl) {
+  auto addTextGlyph = [&](const GlyphInfo& glyphInfo, glm::vec2 offset, const HlRender& hl) {
     glm::vec2 quadPos{
       offset.x,
       offset.y + (glyphInfo.useAscender ? ascender : 0),
@@ -242,7 +269,7 @@ textureReset:
     if (glyphInfo.isEmoji) {
       quadData = &emojiData;
     } else {
-      foreground = hlManager.GetForeground(hl);
+      foreground = hl.foreground;
       quadData = &textData;
     }
 
@@ -258,7 +285,7 @@ textureReset:
     if (run.empty()) return;
     float startX = run.startCol * charSize.x;
     float cellAdvance = 0;
-    Highlight& hl = hlManager.hlTable[run.hlId];
+    const HlRender& hl = hlManager.Get(run.hlId);
 
     for (ShapedGlyph& sg : fontFamily.ShapeText(run.text, run.font)) {
       if (sg.glyphInfo) {
@@ -285,10 +312,15 @@ textureReset:
     textIntervals.push_back(textData.quadCount);
     emojiIntervals.push_back(emojiData.quadCount);
 
+    if (!renderRows[row]) {
+      textOffset.y += charSize.y;
+      continue;
+    }
+
     for (size_t col = 0; col < cols; col++) {
       auto& cell = line[col];
-      const Highlight& hl = hlManager.hlTable[cell.hlId];
-      auto hlBg = hlManager.GetBackground(hl);
+      const HlRender& hl = hlManager.Get(cell.hlId);
+      const auto& hlBg = hl.background;
       // don't render background if same as default background
       if (hlBg != defaultBg) {
         auto rectPositions = MakeRegion({0, 0}, charSize);
@@ -301,15 +333,20 @@ textureReset:
       }
 
       try {
-        auto [kind, font] = fontFamily.ResolveFont(cell.text, hl.bold, hl.italic);
         using Kind = FontFamily::ResolvedFont::Kind;
+        const auto& text = win.grid.Text(cell);
+        // blank cells are skipped without looking at the text
+        auto [kind, font] =
+          cell.grapheme == GraphemeTable::space || cell.grapheme == GraphemeTable::empty
+            ? FontFamily::ResolvedFont{Kind::Skip}
+            : fontFamily.ResolveFont(text, hl.bold, hl.italic);
 
         if (kind == Kind::Regular) {
           // RTL cells: Neovim pre-shapes and sends in visual order.
           // Shape per-cell so HarfBuzz handles base + combining diacritics correctly.
-          if (IsRTLText(cell.text)) {
+          if (IsRTLText(text)) {
             flushRun();
-            for (auto& sg : fontFamily.ShapeText(cell.text, font)) {
+            for (auto& sg : fontFamily.ShapeText(text, font)) {
               if (sg.glyphInfo) {
                 float xOffset = sg.glyphInfo->isEmoji ? 0 : sg.xOffset;
                 addTextGlyph(*sg.glyphInfo, {textOffset.x + xOffset, textOffset.y}, hl);
@@ -319,15 +356,15 @@ textureReset:
           } else if (font != run.font || cell.hlId != run.hlId) {
             flushRun();
             run = RunData{.font = font, .hlId = cell.hlId, .startCol = col};
-            run.text += cell.text;
+            run.text += text;
 
           } else {
-            run.text += cell.text;
+            run.text += text;
           }
 
         } else if (kind == Kind::ShapeDrawing) {
           flushRun();
-          if (const auto* glyphInfo = fontFamily.GetGlyphInfo(cell.text)) {
+          if (const auto* glyphInfo = fontFamily.GetGlyphInfo(text)) {
             addTextGlyph(*glyphInfo, textOffset, hl);
           }
 
@@ -363,7 +400,7 @@ textureReset:
             fontFamily.GetGlyphInfo(StrikethroughTag{}),
             ascender - strikeoutPosition,
             true,
-            hlManager.GetForeground(hl)
+            hl.foreground
           );
         }
 
@@ -372,7 +409,7 @@ textureReset:
             fontFamily.GetGlyphInfo(*hl.underline),
             ascender - underlinePosition,
             true,
-            hlManager.GetSpecial(hl)
+            hl.special
           );
         }
 
@@ -408,67 +445,117 @@ textureReset:
   fontFamily.textureAtlas.Update();
   fontFamily.colorTextureAtlas.Update();
 
-  auto renderInfos = win.sRenderTexture.GetRenderInfos(rows);
+  // rows to render per texture, clear quads are all written before the
+  // passes, since buffer writes land before the command buffer runs
+  struct TextureDraw {
+    const RenderTexture* texture;
+    bool clear; // clear the whole texture, else load it
+    size_t clearStart;
+    size_t clearEnd;
+    std::vector<std::pair<int, int>> runs;
+  };
+  std::vector<TextureDraw> draws;
+
+  auto& clearData = sRenderTexture.clearData;
+  clearData.ResetCounts();
+  auto addClearQuad = [&](const GRect& rect) {
+    auto region = rect.Region();
+    auto& quad = clearData.NextQuad();
+    for (size_t i = 0; i < 4; i++) {
+      quad[i].position = region[i];
+      quad[i].color = ToGlmColor(clearColor);
+    }
+  };
 
   for (auto& [renderTexture, range, clearRegion] : renderInfos) {
+    TextureDraw draw{
+      .texture = renderTexture,
+      .clear = renderAll && !clearRegion.has_value(),
+      .clearStart = clearData.quadCount,
+    };
+    if (renderAll) {
+      if (clearRegion.has_value()) addClearQuad(*clearRegion);
+      draw.runs.emplace_back(range.start, range.end);
+    } else {
+      // untouched rows keep what's already in the texture
+      renderRows.ForEachRun(range.start, range.end, [&](int start, int end) {
+        addClearQuad(GRect{
+          .pos = {0, start * charSize.y},
+          .size = {sRenderTexture.size.x, (end - start) * charSize.y},
+        });
+        draw.runs.emplace_back(start, end);
+      });
+      if (draw.runs.empty()) continue;
+    }
+    draw.clearEnd = clearData.quadCount;
+    draws.push_back(std::move(draw));
+  }
+  if (clearData.quadCount > 0) clearData.WriteBuffers();
+
+  // draws the quads of each run
+  auto renderRuns = [](
+    const RenderPassEncoder& passEncoder, const auto& quadData,
+    const std::vector<int>& intervals, const TextureDraw& draw
+  ) {
+    for (auto [startRow, endRow] : draw.runs) {
+      int start = intervals[startRow];
+      int end = intervals[endRow];
+      if (start != end) quadData.Render(passEncoder, start, end - start);
+    }
+  };
+  auto hasQuads = [](const std::vector<int>& intervals, const TextureDraw& draw) {
+    return std::ranges::any_of(draw.runs, [&](auto run) {
+      return intervals[run.first] != intervals[run.second];
+    });
+  };
+
+  for (const auto& draw : draws) {
+    const auto* renderTexture = draw.texture;
+
     // clear window, and render backgrounds
-    int start = rectIntervals[range.start];
-    int end = rectIntervals[range.end];
     {
-      auto& currRPD = clearRegion.has_value() ? rectNoClearRPD : rectRPD;
+      auto& currRPD = draw.clear ? rectRPD : rectNoClearRPD;
       currRPD.cColorAttachments[0].view = renderTexture->textureView;
       currRPD.cColorAttachments[0].clearValue = linearClearColor;
       RenderPassEncoder passEncoder = commandEncoder.BeginRenderPass(&currRPD);
       passEncoder.SetPipeline(ctx.pipeline.rectRPL);
       passEncoder.SetBindGroup(0, renderTexture->camera.viewProjBG);
 
-      // this will only be ran at most once inside this loop,
-      // so it's safe reset and write buffers directly inside
-      if (clearRegion.has_value()) {
-        auto& clearData = win.sRenderTexture.clearData;
-        clearData.ResetCounts();
-        auto region = clearRegion->Region();
-        auto& quad = clearData.NextQuad();
-        for (size_t i = 0; i < 4; i++) {
-          quad[i].position = region[i];
-          quad[i].color = ToGlmColor(clearColor);
-        }
-        clearData.WriteBuffers();
-        clearData.Render(passEncoder);
+      if (draw.clearStart != draw.clearEnd) {
+        clearData.Render(passEncoder, draw.clearStart, draw.clearEnd - draw.clearStart);
       }
 
-      if (start != end) rectData.Render(passEncoder, start, end - start);
+      renderRuns(passEncoder, rectData, rectIntervals, draw);
       passEncoder.End();
     }
 
     // render text and shapes
     textRPD.cColorAttachments[0].view = renderTexture->textureView;
 
-    start = textIntervals[range.start];
-    end = textIntervals[range.end];
-    if (start != end) {
+    if (hasQuads(textIntervals, draw)) {
       RenderPassEncoder passEncoder = commandEncoder.BeginRenderPass(&textRPD);
       passEncoder.SetPipeline(ctx.pipeline.textRPL);
       passEncoder.SetBindGroup(0, renderTexture->camera.viewProjBG);
       passEncoder.SetBindGroup(1, fontFamily.textureAtlas.textureSizeBG);
       passEncoder.SetBindGroup(2, fontFamily.textureAtlas.renderTexture.textureBG);
-      if (start != end) textData.Render(passEncoder, start, end - start);
+      renderRuns(passEncoder, textData, textIntervals, draw);
       passEncoder.End();
     }
 
-    start = emojiIntervals[range.start];
-    end = emojiIntervals[range.end];
-    if (start != end) {
+    if (hasQuads(emojiIntervals, draw)) {
       RenderPassEncoder passEncoder = commandEncoder.BeginRenderPass(&textRPD);
       passEncoder.SetPipeline(ctx.pipeline.emojiRPL);
       passEncoder.SetBindGroup(0, renderTexture->camera.viewProjBG);
       passEncoder.SetBindGroup(1, fontFamily.colorTextureAtlas.textureSizeBG);
       passEncoder.SetBindGroup(2, fontFamily.colorTextureAtlas.renderTexture.textureBG);
-      if (start != end) emojiData.Render(passEncoder, start, end - start);
+      renderRuns(passEncoder, emojiData, emojiIntervals, draw);
       passEncoder.End();
     }
   }
 
+  sRenderTexture.SetRendered(rows);
+  win.grid.damage.Clear();
+
   rectRPD.cColorAttachments[0].view = {};
   rectNoClearRPD.cColorAttachments[0].view = {};
   textRPD.cColorAttachments[0].view = {};
@@ -479,19 +566,20 @@ void Renderer::RenderCursorMask(
 ) {
   if (!win.grid.ValidCoords(cursor.row, cursor.col)) return;
   auto& cell = win.grid.lines[cursor.row][cursor.col];
-  const auto& hl = hlManager.hlTable[cell.hlId];
+  const auto& text = win.grid.Text(cell);
+  const auto& hl = hlManager.Get(cell.hlId);
   const float ascender = fontFamily.GetAscender();
 
   const GlyphInfo* glyphInfo = nullptr;
-  auto [kind, font] = fontFamily.ResolveFont(cell.text, hl.bold, hl.italic);
+  auto [kind, font] = fontFamily.ResolveFont(text, hl.bold, hl.italic);
   using Kind = FontFamily::ResolvedFont::Kind;
 
   if (kind == Kind::Regular) {
-    for (auto& sg : fontFamily.ShapeText(cell.text, font)) {
+    for (auto& sg : fontFamily.ShapeText(text, font)) {
       if (sg.glyphInfo) { glyphInfo = sg.glyphInfo; break; }
     }
   } else if (kind == Kind::ShapeDrawing) {
-    glyphInfo = fontFamily.GetGlyphInfo(cell.text);
+    glyphInfo = fontFamily.GetGlyphInfo(text);
   }
 
   cursor.onEmoji = glyphInfo && glyphInfo->isEmoji;
@@ -598,9 +686,9 @@ void Renderer::RenderFinalTexture() {
 
 void Renderer::RenderCursor(const Cursor& cursor, HlManager& hlManager) {
   auto attrId = cursor.cursorMode->attrId;
-  const auto& hl = hlManager.hlTable[attrId];
-  auto foreground = hlManager.GetForeground(hl);
-  auto background = hlManager.GetBackground(hl);
+  const auto& hl = hlManager.Get(attrId);
+  auto foreground = hl.foreground;
+  auto background = hl.background;
   if (attrId == 0) std::swap(foreground, background);
 
   cursorData.ResetCounts();
@@ -633,15 +721,16 @@ void Renderer::RenderCursorEmoji(
   if (!win.grid.ValidCoords(cursor.row, cursor.col)) return;
 
   auto& cell = win.grid.lines[cursor.row][cursor.col];
-  const auto& hl = hlManager.hlTable[cell.hlId];
-  auto [kind, font] = fontFamily.ResolveFont(cell.text, hl.bold, hl.italic);
+  const auto& text = win.grid.Text(cell);
+  const auto& hl = hlManager.Get(cell.hlId);
+  auto [kind, font] = fontFamily.ResolveFont(text, hl.bold, hl.italic);
   using Kind = FontFamily::ResolvedFont::Kind;
   if (kind != Kind::Regular) return;
 
   const float ascender = fontFamily.GetAscender();
 
   cursorEmojiOverlayData.ResetCounts();
-  for (ShapedGlyph& sg : fontFamily.ShapeText(cell.text, font)) {
+  for (ShapedGlyph& sg : fontFamily.ShapeText(text, font)) {
     if (!sg.glyphInfo || !sg.glyphInfo->isEmoji) continue;
     glm::vec2 quadPos{
       cursor.maskPos.x,
@@ -33,6 +33,9 @@ struct Renderer {
 
   Ortho2D camera;
 
+  // rows of the window being rendered that need rebuilding
+  RowDamage renderRows;
+
   bool resize = false;
   bool postProcessing = false;
 
@@ -26,6 +26,7 @@
 #include "utils/logger.hpp"
 #include "utils/thread.hpp"
 #include "utils/timer.hpp"
+#include "utils/trace.hpp"
 
 #include <boost/core/typeinfo.hpp>
 #include <algorithm>
@@ -50,6 +51,9 @@ int main(int argc, char** argv) {
   if (!optionsResult) return optionsResult.error();
   StartupOptions startupOpts = *optionsResult;
 
+  TRACE_THREAD_NAME("main");
+  trace::SetEnabled(!startupOpts.trace.empty());
+
   SetupPaths();
 
   // SDL ------------------------------------------------
@@ -77,7 +81,7 @@ int main(int argc, char** argv) {
     );
     EventManager eventManager(sessionManager);
 
-    sessionManager.SessionNew();
+    sessionManager.SessionNew({.address = startupOpts.server});
     SessionHandle session = sessionManager.CurrSession();
     SessionOptions* options = &session->sessionOpts;
     Nvim* nvim = &session->nvim;
@@ -95,6 +99,7 @@ int main(int argc, char** argv) {
     int frameCount = 0;
 
     std::jthread renderThread([&](std::stop_token stopToken) {
+      TRACE_THREAD_NAME("render");
       bool windowFocused = true;
       bool windowOccluded = false;
 
@@ -111,6 +116,7 @@ int main(int argc, char** argv) {
 
       // main loop
       while (!exitWindow && !stopToken.stop_requested()) {
+        TRACE_SCOPE("frame");
 
         // session handling ------------------------------------------
         if (auto* sessionPtr = sessionManager.GetCurrentSession()) {
@@ -230,7 +236,7 @@ int main(int argc, char** argv) {
         // nvim events  -------------------------------------------
         LOG_DISABLE();
         eventManager.ProcessSessionEvents(session);
-        if (session->uiEvents.numFlushes > 0) {
+        if (session->uiEvents->numFlushes > 0) {
           IdleReset();
         }
 
@@ -483,6 +489,10 @@ int main(int argc, char** argv) {
     LOG_ERR("Exiting...");
   }
 
+  if (!startupOpts.trace.empty()) {
+    trace::WriteChromeTrace(startupOpts.trace);
+  }
+
   // destructors cleans up window and font before quitting sdl and freetype
   // FtDone();
   SDL_Quit();
@@ -0,0 +1,2825 @@
+// generated by scripts/gen_api.py from docs/api.txt, do not edit
+// nvim 0.11.0, api level 13
+#pragma once
+
+#include "./api_types.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace api {
+
+enum class Method : uint16_t {
+  BufAddHighlight,
+  BufAttach,
+  BufClearNamespace,
+  BufCreateUserCommand,
+  BufDelExtmark,
+  BufDelKeymap,
+  BufDelMark,
+  BufDelUserCommand,
+  BufDelVar,
+  BufDelete,
+  BufDetach,
+  BufGetChangedtick,
+  BufGetCommands,
+  BufGetExtmarkById,
+  BufGetExtmarks,
+  BufGetKeymap,
+  BufGetLines,
+  BufGetMark,
+  BufGetName,
+  BufGetOffset,
+  BufGetText,
+  BufGetVar,
+  BufIsLoaded,
+  BufIsValid,
+  BufLineCount,
+  BufSetExtmark,
+  BufSetKeymap,
+  BufSetLines,
+  BufSetMark,
+  BufSetName,
+  BufSetText,
+  BufSetVar,
+  CallDictFunction,
+  CallFunction,
+  ChanSend,
+  ClearAutocmds,
+  Cmd,
+  Command,
+  CreateAugroup,
+  CreateAutocmd,
+  CreateBuf,
+  CreateNamespace,
+  CreateUserCommand,
+  DelAugroupById,
+  DelAugroupByName,
+  DelAutocmd,
+  DelCurrentLine,
+  DelKeymap,
+  DelMark,
+  DelUserCommand,
+  DelVar,
+  Echo,
+  ErrWrite,
+  ErrWriteln,
+  Eval,
+  EvalStatusline,
+  Exec2,
+  ExecAutocmds,
+  ExecLua,
+  Feedkeys,
+  GetAllOptionsInfo,
+  GetApiInfo,
+  GetAutocmds,
+  GetChanInfo,
+  GetColorByName,
+  GetColorMap,
+  GetCommands,
+  GetContext,
+  GetCurrentBuf,
+  GetCurrentLine,
+  GetCurrentTabpage,
+  GetCurrentWin,
+  GetHl,
+  GetHlIdByName,
+  GetHlNs,
+  GetKeymap,
+  GetMark,
+  GetMode,
+  GetNamespaces,
+  GetOptionInfo2,
+  GetOptionValue,
+  GetProc,
+  GetProcChildren,
+  GetRuntimeFile,
+  GetVar,
+  GetVvar,
+  Input,
+  InputMouse,
+  ListBufs,
+  ListChans,
+  ListRuntimePaths,
+  ListTabpages,
+  ListUis,
+  ListWins,
+  LoadContext,
+  Notify,
+  OpenTerm,
+  OpenWin,
+  OutWrite,
+  ParseCmd,
+  ParseExpression,
+  Paste,
+  Put,
+  ReplaceTermcodes,
+  SelectPopupmenuItem,
+  SetClientInfo,
+  SetCurrentBuf,
+  SetCurrentDir,
+  SetCurrentLine,
+  SetCurrentTabpage,
+  SetCurrentWin,
+  SetDecorationProvider,
+  SetHl,
+  SetHlNs,
+  SetHlNsFast,
+  SetKeymap,
+  SetOptionValue,
+  SetVar,
+  SetVvar,
+  Strwidth,
+  TabpageDelVar,
+  TabpageGetNumber,
+  TabpageGetVar,
+  TabpageGetWin,
+  TabpageIsValid,
+  TabpageListWins,
+  TabpageSetVar,
+  TabpageSetWin,
+  UiAttach,
+  UiDetach,
+  UiPumSetBounds,
+  UiPumSetHeight,
+  UiSetFocus,
+  UiSetOption,
+  UiTermEvent,
+  UiTryResize,
+  UiTryResizeGrid,
+  WinClose,
+  WinDelVar,
+  WinGetBuf,
+  WinGetConfig,
+  WinGetCursor,
+  WinGetHeight,
+  WinGetNumber,
+  WinGetPosition,
+  WinGetTabpage,
+  WinGetVar,
+  WinGetWidth,
+  WinHide,
+  WinIsValid,
+  WinSetBuf,
+  WinSetConfig,
+  WinSetCursor,
+  WinSetHeight,
+  WinSetHlNs,
+  WinSetVar,
+  WinSetWidth,
+  WinTextHeight,
+};
+
+inline constexpr std::array<std::string_view, 158> methodNames{
+  "nvim_buf_add_highlight",
+  "nvim_buf_attach",
+  "nvim_buf_clear_namespace",
+  "nvim_buf_create_user_command",
+  "nvim_buf_del_extmark",
+  "nvim_buf_del_keymap",
+  "nvim_buf_del_mark",
+  "nvim_buf_del_user_command",
+  "nvim_buf_del_var",
+  "nvim_buf_delete",
+  "nvim_buf_detach",
+  "nvim_buf_get_changedtick",
+  "nvim_buf_get_commands",
+  "nvim_buf_get_extmark_by_id",
+  "nvim_buf_get_extmarks",
+  "nvim_buf_get_keymap",
+  "nvim_buf_get_lines",
+  "nvim_buf_get_mark",
+  "nvim_buf_get_name",
+  "nvim_buf_get_offset",
+  "nvim_buf_get_text",
+  "nvim_buf_get_var",
+  "nvim_buf_is_loaded",
+  "nvim_buf_is_valid",
+  "nvim_buf_line_count",
+  "nvim_buf_set_extmark",
+  "nvim_buf_set_keymap",
+  "nvim_buf_set_lines",
+  "nvim_buf_set_mark",
+  "nvim_buf_set_name",
+  "nvim_buf_set_text",
+  "nvim_buf_set_var",
+  "nvim_call_dict_function",
+  "nvim_call_function",
+  "nvim_chan_send",
+  "nvim_clear_autocmds",
+  "nvim_cmd",
+  "nvim_command",
+  "nvim_create_augroup",
+  "nvim_create_autocmd",
+  "nvim_create_buf",
+  "nvim_create_namespace",
+  "nvim_create_user_command",
+  "nvim_del_augroup_by_id",
+  "nvim_del_augroup_by_name",
+  "nvim_del_autocmd",
+  "nvim_del_current_line",
+  "nvim_del_keymap",
+  "nvim_del_mark",
+  "nvim_del_user_command",
+  "nvim_del_var",
+  "nvim_echo",
+  "nvim_err_write",
+  "nvim_err_writeln",
+  "nvim_eval",
+  "nvim_eval_statusline",
+  "nvim_exec2",
+  "nvim_exec_autocmds",
+  "nvim_exec_lua",
+  "nvim_feedkeys",
+  "nvim_get_all_options_info",
+  "nvim_get_api_info",
+  "nvim_get_autocmds",
+  "nvim_get_chan_info",
+  "nvim_get_color_by_name",
+  "nvim_get_color_map",
+  "nvim_get_commands",
+  "nvim_get_context",
+  "nvim_get_current_buf",
+  "nvim_get_current_line",
+  "nvim_get_current_tabpage",
+  "nvim_get_current_win",
+  "nvim_get_hl",
+  "nvim_get_hl_id_by_name",
+  "nvim_get_hl_ns",
+  "nvim_get_keymap",
+  "nvim_get_mark",
+  "nvim_get_mode",
+  "nvim_get_namespaces",
+  "nvim_get_option_info2",
+  "nvim_get_option_value",
+  "nvim_get_proc",
+  "nvim_get_proc_children",
+  "nvim_get_runtime_file",
+  "nvim_get_var",
+  "nvim_get_vvar",
+  "nvim_input",
+  "nvim_input_mouse",
+  "nvim_list_bufs",
+  "nvim_list_chans",
+  "nvim_list_runtime_paths",
+  "nvim_list_tabpages",
+  "nvim_list_uis",
+  "nvim_list_wins",
+  "nvim_load_context",
+  "nvim_notify",
+  "nvim_open_term",
+  "nvim_open_win",
+  "nvim_out_write",
+  "nvim_parse_cmd",
+  "nvim_parse_expression",
+  "nvim_paste",
+  "nvim_put",
+  "nvim_replace_termcodes",
+  "nvim_select_popupmenu_item",
+  "nvim_set_client_info",
+  "nvim_set_current_buf",
+  "nvim_set_current_dir",
+  "nvim_set_current_line",
+  "nvim_set_current_tabpage",
+  "nvim_set_current_win",
+  "nvim_set_decoration_provider",
+  "nvim_set_hl",
+  "nvim_set_hl_ns",
+  "nvim_set_hl_ns_fast",
+  "nvim_set_keymap",
+  "nvim_set_option_value",
+  "nvim_set_var",
+  "nvim_set_vvar",
+  "nvim_strwidth",
+  "nvim_tabpage_del_var",
+  "nvim_tabpage_get_number",
+  "nvim_tabpage_get_var",
+  "nvim_tabpage_get_win",
+  "nvim_tabpage_is_valid",
+  "nvim_tabpage_list_wins",
+  "nvim_tabpage_set_var",
+  "nvim_tabpage_set_win",
+  "nvim_ui_attach",
+  "nvim_ui_detach",
+  "nvim_ui_pum_set_bounds",
+  "nvim_ui_pum_set_height",
+  "nvim_ui_set_focus",
+  "nvim_ui_set_option",
+  "nvim_ui_term_event",
+  "nvim_ui_try_resize",
+  "nvim_ui_try_resize_grid",
+  "nvim_win_close",
+  "nvim_win_del_var",
+  "nvim_win_get_buf",
+  "nvim_win_get_config",
+  "nvim_win_get_cursor",
+  "nvim_win_get_height",
+  "nvim_win_get_number",
+  "nvim_win_get_position",
+  "nvim_win_get_tabpage",
+  "nvim_win_get_var",
+  "nvim_win_get_width",
+  "nvim_win_hide",
+  "nvim_win_is_valid",
+  "nvim_win_set_buf",
+  "nvim_win_set_config",
+  "nvim_win_set_cursor",
+  "nvim_win_set_height",
+  "nvim_win_set_hl_ns",
+  "nvim_win_set_var",
+  "nvim_win_set_width",
+  "nvim_win_text_height",
+};
+
+constexpr std::string_view MethodName(Method method) {
+  return methodNames[size_t(method)];
+}
+
+// since api level 1
+struct BufAddHighlight {
+  static constexpr Method method = Method::BufAddHighlight;
+  static constexpr std::string_view methodName = "nvim_buf_add_highlight";
+  using Result = int64_t;
+  Handle buffer;
+  int64_t nsId;
+  std::string_view hlGroup;
+  int64_t line;
+  int64_t colStart;
+  int64_t colEnd;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(6);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(hlGroup);
+    o.pack(line);
+    o.pack(colStart);
+    o.pack(colEnd);
+  }
+};
+
+// since api level 4
+struct BufAttach {
+  static constexpr Method method = Method::BufAttach;
+  static constexpr std::string_view methodName = "nvim_buf_attach";
+  using Result = bool;
+  Handle buffer;
+  bool sendBuffer;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(buffer);
+    o.pack(sendBuffer);
+    o.pack(opts);
+  }
+};
+
+// since api level 5
+struct BufClearNamespace {
+  static constexpr Method method = Method::BufClearNamespace;
+  static constexpr std::string_view methodName = "nvim_buf_clear_namespace";
+  using Result = void;
+  Handle buffer;
+  int64_t nsId;
+  int64_t lineStart;
+  int64_t lineEnd;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(lineStart);
+    o.pack(lineEnd);
+  }
+};
+
+// since api level 9
+struct BufCreateUserCommand {
+  static constexpr Method method = Method::BufCreateUserCommand;
+  static constexpr std::string_view methodName = "nvim_buf_create_user_command";
+  using Result = void;
+  Handle buffer;
+  std::string_view name;
+  ObjectRef command;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(buffer);
+    o.pack(name);
+    o.pack(command);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct BufDelExtmark {
+  static constexpr Method method = Method::BufDelExtmark;
+  static constexpr std::string_view methodName = "nvim_buf_del_extmark";
+  using Result = bool;
+  Handle buffer;
+  int64_t nsId;
+  int64_t id;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(id);
+  }
+};
+
+// since api level 6
+struct BufDelKeymap {
+  static constexpr Method method = Method::BufDelKeymap;
+  static constexpr std::string_view methodName = "nvim_buf_del_keymap";
+  using Result = void;
+  Handle buffer;
+  std::string_view mode;
+  std::string_view lhs;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(buffer);
+    o.pack(mode);
+    o.pack(lhs);
+  }
+};
+
+// since api level 8
+struct BufDelMark {
+  static constexpr Method method = Method::BufDelMark;
+  static constexpr std::string_view methodName = "nvim_buf_del_mark";
+  using Result = bool;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 9
+struct BufDelUserCommand {
+  static constexpr Method method = Method::BufDelUserCommand;
+  static constexpr std::string_view methodName = "nvim_buf_del_user_command";
+  using Result = void;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct BufDelVar {
+  static constexpr Method method = Method::BufDelVar;
+  static constexpr std::string_view methodName = "nvim_buf_del_var";
+  using Result = void;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 7
+struct BufDelete {
+  static constexpr Method method = Method::BufDelete;
+  static constexpr std::string_view methodName = "nvim_buf_delete";
+  using Result = void;
+  Handle buffer;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(opts);
+  }
+};
+
+// since api level 4
+struct BufDetach {
+  static constexpr Method method = Method::BufDetach;
+  static constexpr std::string_view methodName = "nvim_buf_detach";
+  using Result = bool;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 2
+struct BufGetChangedtick {
+  static constexpr Method method = Method::BufGetChangedtick;
+  static constexpr std::string_view methodName = "nvim_buf_get_changedtick";
+  using Result = int64_t;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 4
+struct BufGetCommands {
+  static constexpr Method method = Method::BufGetCommands;
+  static constexpr std::string_view methodName = "nvim_buf_get_commands";
+  using Result = Dict;
+  Handle buffer;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct BufGetExtmarkById {
+  static constexpr Method method = Method::BufGetExtmarkById;
+  static constexpr std::string_view methodName = "nvim_buf_get_extmark_by_id";
+  using Result = std::vector<int64_t>;
+  Handle buffer;
+  int64_t nsId;
+  int64_t id;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(id);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct BufGetExtmarks {
+  static constexpr Method method = Method::BufGetExtmarks;
+  static constexpr std::string_view methodName = "nvim_buf_get_extmarks";
+  using Result = Array;
+  Handle buffer;
+  int64_t nsId;
+  ObjectRef start;
+  ObjectRef end_;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(start);
+    o.pack(end_);
+    o.pack(opts);
+  }
+};
+
+// since api level 3
+struct BufGetKeymap {
+  static constexpr Method method = Method::BufGetKeymap;
+  static constexpr std::string_view methodName = "nvim_buf_get_keymap";
+  using Result = std::vector<Dict>;
+  Handle buffer;
+  std::string_view mode;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(mode);
+  }
+};
+
+// since api level 1
+struct BufGetLines {
+  static constexpr Method method = Method::BufGetLines;
+  static constexpr std::string_view methodName = "nvim_buf_get_lines";
+  using Result = std::vector<std::string>;
+  Handle buffer;
+  int64_t start;
+  int64_t end_;
+  bool strictIndexing;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(buffer);
+    o.pack(start);
+    o.pack(end_);
+    o.pack(strictIndexing);
+  }
+};
+
+// since api level 1
+struct BufGetMark {
+  static constexpr Method method = Method::BufGetMark;
+  static constexpr std::string_view methodName = "nvim_buf_get_mark";
+  using Result = std::array<int64_t, 2>;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct BufGetName {
+  static constexpr Method method = Method::BufGetName;
+  static constexpr std::string_view methodName = "nvim_buf_get_name";
+  using Result = std::string;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 5
+struct BufGetOffset {
+  static constexpr Method method = Method::BufGetOffset;
+  static constexpr std::string_view methodName = "nvim_buf_get_offset";
+  using Result = int64_t;
+  Handle buffer;
+  int64_t index;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(index);
+  }
+};
+
+// since api level 9
+struct BufGetText {
+  static constexpr Method method = Method::BufGetText;
+  static constexpr std::string_view methodName = "nvim_buf_get_text";
+  using Result = std::vector<std::string>;
+  Handle buffer;
+  int64_t startRow;
+  int64_t startCol;
+  int64_t endRow;
+  int64_t endCol;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(6);
+    o.pack(buffer);
+    o.pack(startRow);
+    o.pack(startCol);
+    o.pack(endRow);
+    o.pack(endCol);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct BufGetVar {
+  static constexpr Method method = Method::BufGetVar;
+  static constexpr std::string_view methodName = "nvim_buf_get_var";
+  using Result = Object;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 5
+struct BufIsLoaded {
+  static constexpr Method method = Method::BufIsLoaded;
+  static constexpr std::string_view methodName = "nvim_buf_is_loaded";
+  using Result = bool;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 1
+struct BufIsValid {
+  static constexpr Method method = Method::BufIsValid;
+  static constexpr std::string_view methodName = "nvim_buf_is_valid";
+  using Result = bool;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 1
+struct BufLineCount {
+  static constexpr Method method = Method::BufLineCount;
+  static constexpr std::string_view methodName = "nvim_buf_line_count";
+  using Result = int64_t;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 7
+struct BufSetExtmark {
+  static constexpr Method method = Method::BufSetExtmark;
+  static constexpr std::string_view methodName = "nvim_buf_set_extmark";
+  using Result = int64_t;
+  Handle buffer;
+  int64_t nsId;
+  int64_t line;
+  int64_t col;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(buffer);
+    o.pack(nsId);
+    o.pack(line);
+    o.pack(col);
+    o.pack(opts);
+  }
+};
+
+// since api level 6
+struct BufSetKeymap {
+  static constexpr Method method = Method::BufSetKeymap;
+  static constexpr std::string_view methodName = "nvim_buf_set_keymap";
+  using Result = void;
+  Handle buffer;
+  std::string_view mode;
+  std::string_view lhs;
+  std::string_view rhs;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(buffer);
+    o.pack(mode);
+    o.pack(lhs);
+    o.pack(rhs);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct BufSetLines {
+  static constexpr Method method = Method::BufSetLines;
+  static constexpr std::string_view methodName = "nvim_buf_set_lines";
+  using Result = void;
+  Handle buffer;
+  int64_t start;
+  int64_t end_;
+  bool strictIndexing;
+  const std::vector<std::string_view>& replacement;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(buffer);
+    o.pack(start);
+    o.pack(end_);
+    o.pack(strictIndexing);
+    o.pack(replacement);
+  }
+};
+
+// since api level 8
+struct BufSetMark {
+  static constexpr Method method = Method::BufSetMark;
+  static constexpr std::string_view methodName = "nvim_buf_set_mark";
+  using Result = bool;
+  Handle buffer;
+  std::string_view name;
+  int64_t line;
+  int64_t col;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(buffer);
+    o.pack(name);
+    o.pack(line);
+    o.pack(col);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct BufSetName {
+  static constexpr Method method = Method::BufSetName;
+  static constexpr std::string_view methodName = "nvim_buf_set_name";
+  using Result = void;
+  Handle buffer;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(name);
+  }
+};
+
+// since api level 7
+struct BufSetText {
+  static constexpr Method method = Method::BufSetText;
+  static constexpr std::string_view methodName = "nvim_buf_set_text";
+  using Result = void;
+  Handle buffer;
+  int64_t startRow;
+  int64_t startCol;
+  int64_t endRow;
+  int64_t endCol;
+  const std::vector<std::string_view>& replacement;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(6);
+    o.pack(buffer);
+    o.pack(startRow);
+    o.pack(startCol);
+    o.pack(endRow);
+    o.pack(endCol);
+    o.pack(replacement);
+  }
+};
+
+// since api level 1
+struct BufSetVar {
+  static constexpr Method method = Method::BufSetVar;
+  static constexpr std::string_view methodName = "nvim_buf_set_var";
+  using Result = void;
+  Handle buffer;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(buffer);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 4
+struct CallDictFunction {
+  static constexpr Method method = Method::CallDictFunction;
+  static constexpr std::string_view methodName = "nvim_call_dict_function";
+  using Result = Object;
+  ObjectRef dict;
+  std::string_view fn;
+  ArrayRef args;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(dict);
+    o.pack(fn);
+    o.pack(args);
+  }
+};
+
+// since api level 1
+struct CallFunction {
+  static constexpr Method method = Method::CallFunction;
+  static constexpr std::string_view methodName = "nvim_call_function";
+  using Result = Object;
+  std::string_view fn;
+  ArrayRef args;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(fn);
+    o.pack(args);
+  }
+};
+
+// since api level 7
+struct ChanSend {
+  static constexpr Method method = Method::ChanSend;
+  static constexpr std::string_view methodName = "nvim_chan_send";
+  using Result = void;
+  int64_t chan;
+  std::string_view data;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(chan);
+    o.pack(data);
+  }
+};
+
+// since api level 9
+struct ClearAutocmds {
+  static constexpr Method method = Method::ClearAutocmds;
+  static constexpr std::string_view methodName = "nvim_clear_autocmds";
+  using Result = void;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(opts);
+  }
+};
+
+// since api level 10
+struct Cmd {
+  static constexpr Method method = Method::Cmd;
+  static constexpr std::string_view methodName = "nvim_cmd";
+  using Result = std::string;
+  DictRef cmd;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(cmd);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct Command {
+  static constexpr Method method = Method::Command;
+  static constexpr std::string_view methodName = "nvim_command";
+  using Result = void;
+  std::string_view command;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(command);
+  }
+};
+
+// since api level 9
+struct CreateAugroup {
+  static constexpr Method method = Method::CreateAugroup;
+  static constexpr std::string_view methodName = "nvim_create_augroup";
+  using Result = int64_t;
+  std::string_view name;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(opts);
+  }
+};
+
+// since api level 9
+struct CreateAutocmd {
+  static constexpr Method method = Method::CreateAutocmd;
+  static constexpr std::string_view methodName = "nvim_create_autocmd";
+  using Result = int64_t;
+  ObjectRef event;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(event);
+    o.pack(opts);
+  }
+};
+
+// since api level 6
+struct CreateBuf {
+  static constexpr Method method = Method::CreateBuf;
+  static constexpr std::string_view methodName = "nvim_create_buf";
+  using Result = Handle;
+  bool listed;
+  bool scratch;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(listed);
+    o.pack(scratch);
+  }
+};
+
+// since api level 5
+struct CreateNamespace {
+  static constexpr Method method = Method::CreateNamespace;
+  static constexpr std::string_view methodName = "nvim_create_namespace";
+  using Result = int64_t;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 9
+struct CreateUserCommand {
+  static constexpr Method method = Method::CreateUserCommand;
+  static constexpr std::string_view methodName = "nvim_create_user_command";
+  using Result = void;
+  std::string_view name;
+  ObjectRef command;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(name);
+    o.pack(command);
+    o.pack(opts);
+  }
+};
+
+// since api level 9
+struct DelAugroupById {
+  static constexpr Method method = Method::DelAugroupById;
+  static constexpr std::string_view methodName = "nvim_del_augroup_by_id";
+  using Result = void;
+  int64_t id;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(id);
+  }
+};
+
+// since api level 9
+struct DelAugroupByName {
+  static constexpr Method method = Method::DelAugroupByName;
+  static constexpr std::string_view methodName = "nvim_del_augroup_by_name";
+  using Result = void;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 9
+struct DelAutocmd {
+  static constexpr Method method = Method::DelAutocmd;
+  static constexpr std::string_view methodName = "nvim_del_autocmd";
+  using Result = void;
+  int64_t id;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(id);
+  }
+};
+
+// since api level 1
+struct DelCurrentLine {
+  static constexpr Method method = Method::DelCurrentLine;
+  static constexpr std::string_view methodName = "nvim_del_current_line";
+  using Result = void;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 6
+struct DelKeymap {
+  static constexpr Method method = Method::DelKeymap;
+  static constexpr std::string_view methodName = "nvim_del_keymap";
+  using Result = void;
+  std::string_view mode;
+  std::string_view lhs;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(mode);
+    o.pack(lhs);
+  }
+};
+
+// since api level 8
+struct DelMark {
+  static constexpr Method method = Method::DelMark;
+  static constexpr std::string_view methodName = "nvim_del_mark";
+  using Result = bool;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 9
+struct DelUserCommand {
+  static constexpr Method method = Method::DelUserCommand;
+  static constexpr std::string_view methodName = "nvim_del_user_command";
+  using Result = void;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct DelVar {
+  static constexpr Method method = Method::DelVar;
+  static constexpr std::string_view methodName = "nvim_del_var";
+  using Result = void;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 7
+struct Echo {
+  static constexpr Method method = Method::Echo;
+  static constexpr std::string_view methodName = "nvim_echo";
+  using Result = void;
+  ArrayRef chunks;
+  bool history;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(chunks);
+    o.pack(history);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct ErrWrite {
+  static constexpr Method method = Method::ErrWrite;
+  static constexpr std::string_view methodName = "nvim_err_write";
+  using Result = void;
+  std::string_view str;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(str);
+  }
+};
+
+// since api level 1
+struct ErrWriteln {
+  static constexpr Method method = Method::ErrWriteln;
+  static constexpr std::string_view methodName = "nvim_err_writeln";
+  using Result = void;
+  std::string_view str;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(str);
+  }
+};
+
+// since api level 1
+struct Eval {
+  static constexpr Method method = Method::Eval;
+  static constexpr std::string_view methodName = "nvim_eval";
+  using Result = Object;
+  std::string_view expr;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(expr);
+  }
+};
+
+// since api level 8
+struct EvalStatusline {
+  static constexpr Method method = Method::EvalStatusline;
+  static constexpr std::string_view methodName = "nvim_eval_statusline";
+  using Result = Dict;
+  std::string_view str;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(str);
+    o.pack(opts);
+  }
+};
+
+// since api level 11
+struct Exec2 {
+  static constexpr Method method = Method::Exec2;
+  static constexpr std::string_view methodName = "nvim_exec2";
+  using Result = Dict;
+  std::string_view src;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(src);
+    o.pack(opts);
+  }
+};
+
+// since api level 9
+struct ExecAutocmds {
+  static constexpr Method method = Method::ExecAutocmds;
+  static constexpr std::string_view methodName = "nvim_exec_autocmds";
+  using Result = void;
+  ObjectRef event;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(event);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct ExecLua {
+  static constexpr Method method = Method::ExecLua;
+  static constexpr std::string_view methodName = "nvim_exec_lua";
+  using Result = Object;
+  std::string_view code;
+  ArrayRef args;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(code);
+    o.pack(args);
+  }
+};
+
+// since api level 1
+struct Feedkeys {
+  static constexpr Method method = Method::Feedkeys;
+  static constexpr std::string_view methodName = "nvim_feedkeys";
+  using Result = void;
+  std::string_view keys;
+  std::string_view mode;
+  bool escapeKs;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(keys);
+    o.pack(mode);
+    o.pack(escapeKs);
+  }
+};
+
+// since api level 7
+struct GetAllOptionsInfo {
+  static constexpr Method method = Method::GetAllOptionsInfo;
+  static constexpr std::string_view methodName = "nvim_get_all_options_info";
+  using Result = Dict;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct GetApiInfo {
+  static constexpr Method method = Method::GetApiInfo;
+  static constexpr std::string_view methodName = "nvim_get_api_info";
+  using Result = Array;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 9
+struct GetAutocmds {
+  static constexpr Method method = Method::GetAutocmds;
+  static constexpr std::string_view methodName = "nvim_get_autocmds";
+  using Result = Array;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(opts);
+  }
+};
+
+// since api level 4
+struct GetChanInfo {
+  static constexpr Method method = Method::GetChanInfo;
+  static constexpr std::string_view methodName = "nvim_get_chan_info";
+  using Result = Dict;
+  int64_t chan;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(chan);
+  }
+};
+
+// since api level 1
+struct GetColorByName {
+  static constexpr Method method = Method::GetColorByName;
+  static constexpr std::string_view methodName = "nvim_get_color_by_name";
+  using Result = int64_t;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct GetColorMap {
+  static constexpr Method method = Method::GetColorMap;
+  static constexpr std::string_view methodName = "nvim_get_color_map";
+  using Result = Dict;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 4
+struct GetCommands {
+  static constexpr Method method = Method::GetCommands;
+  static constexpr std::string_view methodName = "nvim_get_commands";
+  using Result = Dict;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(opts);
+  }
+};
+
+// since api level 6
+struct GetContext {
+  static constexpr Method method = Method::GetContext;
+  static constexpr std::string_view methodName = "nvim_get_context";
+  using Result = Dict;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct GetCurrentBuf {
+  static constexpr Method method = Method::GetCurrentBuf;
+  static constexpr std::string_view methodName = "nvim_get_current_buf";
+  using Result = Handle;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct GetCurrentLine {
+  static constexpr Method method = Method::GetCurrentLine;
+  static constexpr std::string_view methodName = "nvim_get_current_line";
+  using Result = std::string;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct GetCurrentTabpage {
+  static constexpr Method method = Method::GetCurrentTabpage;
+  static constexpr std::string_view methodName = "nvim_get_current_tabpage";
+  using Result = Handle;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct GetCurrentWin {
+  static constexpr Method method = Method::GetCurrentWin;
+  static constexpr std::string_view methodName = "nvim_get_current_win";
+  using Result = Handle;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 11
+struct GetHl {
+  static constexpr Method method = Method::GetHl;
+  static constexpr std::string_view methodName = "nvim_get_hl";
+  using Result = Dict;
+  int64_t nsId;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(nsId);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct GetHlIdByName {
+  static constexpr Method method = Method::GetHlIdByName;
+  static constexpr std::string_view methodName = "nvim_get_hl_id_by_name";
+  using Result = int64_t;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 12
+struct GetHlNs {
+  static constexpr Method method = Method::GetHlNs;
+  static constexpr std::string_view methodName = "nvim_get_hl_ns";
+  using Result = int64_t;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(opts);
+  }
+};
+
+// since api level 3
+struct GetKeymap {
+  static constexpr Method method = Method::GetKeymap;
+  static constexpr std::string_view methodName = "nvim_get_keymap";
+  using Result = std::vector<Dict>;
+  std::string_view mode;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(mode);
+  }
+};
+
+// since api level 8
+struct GetMark {
+  static constexpr Method method = Method::GetMark;
+  static constexpr std::string_view methodName = "nvim_get_mark";
+  using Result = Array;
+  std::string_view name;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(opts);
+  }
+};
+
+// since api level 2
+struct GetMode {
+  static constexpr Method method = Method::GetMode;
+  static constexpr std::string_view methodName = "nvim_get_mode";
+  using Result = Dict;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 5
+struct GetNamespaces {
+  static constexpr Method method = Method::GetNamespaces;
+  static constexpr std::string_view methodName = "nvim_get_namespaces";
+  using Result = Dict;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 11
+struct GetOptionInfo2 {
+  static constexpr Method method = Method::GetOptionInfo2;
+  static constexpr std::string_view methodName = "nvim_get_option_info2";
+  using Result = Dict;
+  std::string_view name;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(opts);
+  }
+};
+
+// since api level 9
+struct GetOptionValue {
+  static constexpr Method method = Method::GetOptionValue;
+  static constexpr std::string_view methodName = "nvim_get_option_value";
+  using Result = Object;
+  std::string_view name;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(opts);
+  }
+};
+
+// since api level 4
+struct GetProc {
+  static constexpr Method method = Method::GetProc;
+  static constexpr std::string_view methodName = "nvim_get_proc";
+  using Result = Object;
+  int64_t pid;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(pid);
+  }
+};
+
+// since api level 4
+struct GetProcChildren {
+  static constexpr Method method = Method::GetProcChildren;
+  static constexpr std::string_view methodName = "nvim_get_proc_children";
+  using Result = Array;
+  int64_t pid;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(pid);
+  }
+};
+
+// since api level 7
+struct GetRuntimeFile {
+  static constexpr Method method = Method::GetRuntimeFile;
+  static constexpr std::string_view methodName = "nvim_get_runtime_file";
+  using Result = std::vector<std::string>;
+  std::string_view name;
+  bool all;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(all);
+  }
+};
+
+// since api level 1
+struct GetVar {
+  static constexpr Method method = Method::GetVar;
+  static constexpr std::string_view methodName = "nvim_get_var";
+  using Result = Object;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct GetVvar {
+  static constexpr Method method = Method::GetVvar;
+  static constexpr std::string_view methodName = "nvim_get_vvar";
+  using Result = Object;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct Input {
+  static constexpr Method method = Method::Input;
+  static constexpr std::string_view methodName = "nvim_input";
+  using Result = int64_t;
+  std::string_view keys;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(keys);
+  }
+};
+
+// since api level 6
+struct InputMouse {
+  static constexpr Method method = Method::InputMouse;
+  static constexpr std::string_view methodName = "nvim_input_mouse";
+  using Result = void;
+  std::string_view button;
+  std::string_view action;
+  std::string_view modifier;
+  int64_t grid;
+  int64_t row;
+  int64_t col;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(6);
+    o.pack(button);
+    o.pack(action);
+    o.pack(modifier);
+    o.pack(grid);
+    o.pack(row);
+    o.pack(col);
+  }
+};
+
+// since api level 1
+struct ListBufs {
+  static constexpr Method method = Method::ListBufs;
+  static constexpr std::string_view methodName = "nvim_list_bufs";
+  using Result = std::vector<Handle>;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 4
+struct ListChans {
+  static constexpr Method method = Method::ListChans;
+  static constexpr std::string_view methodName = "nvim_list_chans";
+  using Result = Array;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct ListRuntimePaths {
+  static constexpr Method method = Method::ListRuntimePaths;
+  static constexpr std::string_view methodName = "nvim_list_runtime_paths";
+  using Result = std::vector<std::string>;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct ListTabpages {
+  static constexpr Method method = Method::ListTabpages;
+  static constexpr std::string_view methodName = "nvim_list_tabpages";
+  using Result = std::vector<Handle>;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 4
+struct ListUis {
+  static constexpr Method method = Method::ListUis;
+  static constexpr std::string_view methodName = "nvim_list_uis";
+  using Result = Array;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 1
+struct ListWins {
+  static constexpr Method method = Method::ListWins;
+  static constexpr std::string_view methodName = "nvim_list_wins";
+  using Result = std::vector<Handle>;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 6
+struct LoadContext {
+  static constexpr Method method = Method::LoadContext;
+  static constexpr std::string_view methodName = "nvim_load_context";
+  using Result = Object;
+  DictRef dict;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(dict);
+  }
+};
+
+// since api level 7
+struct Notify {
+  static constexpr Method method = Method::Notify;
+  static constexpr std::string_view methodName = "nvim_notify";
+  using Result = Object;
+  std::string_view msg;
+  int64_t logLevel;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(msg);
+    o.pack(logLevel);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct OpenTerm {
+  static constexpr Method method = Method::OpenTerm;
+  static constexpr std::string_view methodName = "nvim_open_term";
+  using Result = int64_t;
+  Handle buffer;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(buffer);
+    o.pack(opts);
+  }
+};
+
+// since api level 6
+struct OpenWin {
+  static constexpr Method method = Method::OpenWin;
+  static constexpr std::string_view methodName = "nvim_open_win";
+  using Result = Handle;
+  Handle buffer;
+  bool enter;
+  DictRef config;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(buffer);
+    o.pack(enter);
+    o.pack(config);
+  }
+};
+
+// since api level 1
+struct OutWrite {
+  static constexpr Method method = Method::OutWrite;
+  static constexpr std::string_view methodName = "nvim_out_write";
+  using Result = void;
+  std::string_view str;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(str);
+  }
+};
+
+// since api level 10
+struct ParseCmd {
+  static constexpr Method method = Method::ParseCmd;
+  static constexpr std::string_view methodName = "nvim_parse_cmd";
+  using Result = Dict;
+  std::string_view str;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(str);
+    o.pack(opts);
+  }
+};
+
+// since api level 4
+struct ParseExpression {
+  static constexpr Method method = Method::ParseExpression;
+  static constexpr std::string_view methodName = "nvim_parse_expression";
+  using Result = Dict;
+  std::string_view expr;
+  std::string_view flags;
+  bool highlight;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(expr);
+    o.pack(flags);
+    o.pack(highlight);
+  }
+};
+
+// since api level 6
+struct Paste {
+  static constexpr Method method = Method::Paste;
+  static constexpr std::string_view methodName = "nvim_paste";
+  using Result = bool;
+  std::string_view data;
+  bool crlf;
+  int64_t phase;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(data);
+    o.pack(crlf);
+    o.pack(phase);
+  }
+};
+
+// since api level 6
+struct Put {
+  static constexpr Method method = Method::Put;
+  static constexpr std::string_view methodName = "nvim_put";
+  using Result = void;
+  const std::vector<std::string_view>& lines;
+  std::string_view type;
+  bool after;
+  bool follow;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(lines);
+    o.pack(type);
+    o.pack(after);
+    o.pack(follow);
+  }
+};
+
+// since api level 1
+struct ReplaceTermcodes {
+  static constexpr Method method = Method::ReplaceTermcodes;
+  static constexpr std::string_view methodName = "nvim_replace_termcodes";
+  using Result = std::string;
+  std::string_view str;
+  bool fromPart;
+  bool doLt;
+  bool special;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(str);
+    o.pack(fromPart);
+    o.pack(doLt);
+    o.pack(special);
+  }
+};
+
+// since api level 6
+struct SelectPopupmenuItem {
+  static constexpr Method method = Method::SelectPopupmenuItem;
+  static constexpr std::string_view methodName = "nvim_select_popupmenu_item";
+  using Result = void;
+  int64_t item;
+  bool insert;
+  bool finish;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(item);
+    o.pack(insert);
+    o.pack(finish);
+    o.pack(opts);
+  }
+};
+
+// since api level 4
+struct SetClientInfo {
+  static constexpr Method method = Method::SetClientInfo;
+  static constexpr std::string_view methodName = "nvim_set_client_info";
+  using Result = void;
+  std::string_view name;
+  DictRef version;
+  std::string_view type;
+  DictRef methods;
+  DictRef attributes;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(5);
+    o.pack(name);
+    o.pack(version);
+    o.pack(type);
+    o.pack(methods);
+    o.pack(attributes);
+  }
+};
+
+// since api level 1
+struct SetCurrentBuf {
+  static constexpr Method method = Method::SetCurrentBuf;
+  static constexpr std::string_view methodName = "nvim_set_current_buf";
+  using Result = void;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(buffer);
+  }
+};
+
+// since api level 1
+struct SetCurrentDir {
+  static constexpr Method method = Method::SetCurrentDir;
+  static constexpr std::string_view methodName = "nvim_set_current_dir";
+  using Result = void;
+  std::string_view dir;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(dir);
+  }
+};
+
+// since api level 1
+struct SetCurrentLine {
+  static constexpr Method method = Method::SetCurrentLine;
+  static constexpr std::string_view methodName = "nvim_set_current_line";
+  using Result = void;
+  std::string_view line;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(line);
+  }
+};
+
+// since api level 1
+struct SetCurrentTabpage {
+  static constexpr Method method = Method::SetCurrentTabpage;
+  static constexpr std::string_view methodName = "nvim_set_current_tabpage";
+  using Result = void;
+  Handle tabpage;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(tabpage);
+  }
+};
+
+// since api level 1
+struct SetCurrentWin {
+  static constexpr Method method = Method::SetCurrentWin;
+  static constexpr std::string_view methodName = "nvim_set_current_win";
+  using Result = void;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 7
+struct SetDecorationProvider {
+  static constexpr Method method = Method::SetDecorationProvider;
+  static constexpr std::string_view methodName = "nvim_set_decoration_provider";
+  using Result = void;
+  int64_t nsId;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(nsId);
+    o.pack(opts);
+  }
+};
+
+// since api level 7
+struct SetHl {
+  static constexpr Method method = Method::SetHl;
+  static constexpr std::string_view methodName = "nvim_set_hl";
+  using Result = void;
+  int64_t nsId;
+  std::string_view name;
+  DictRef val;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(nsId);
+    o.pack(name);
+    o.pack(val);
+  }
+};
+
+// since api level 10
+struct SetHlNs {
+  static constexpr Method method = Method::SetHlNs;
+  static constexpr std::string_view methodName = "nvim_set_hl_ns";
+  using Result = void;
+  int64_t nsId;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(nsId);
+  }
+};
+
+// since api level 10
+struct SetHlNsFast {
+  static constexpr Method method = Method::SetHlNsFast;
+  static constexpr std::string_view methodName = "nvim_set_hl_ns_fast";
+  using Result = void;
+  int64_t nsId;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(nsId);
+  }
+};
+
+// since api level 6
+struct SetKeymap {
+  static constexpr Method method = Method::SetKeymap;
+  static constexpr std::string_view methodName = "nvim_set_keymap";
+  using Result = void;
+  std::string_view mode;
+  std::string_view lhs;
+  std::string_view rhs;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(mode);
+    o.pack(lhs);
+    o.pack(rhs);
+    o.pack(opts);
+  }
+};
+
+// since api level 9
+struct SetOptionValue {
+  static constexpr Method method = Method::SetOptionValue;
+  static constexpr std::string_view methodName = "nvim_set_option_value";
+  using Result = void;
+  std::string_view name;
+  ObjectRef value;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(name);
+    o.pack(value);
+    o.pack(opts);
+  }
+};
+
+// since api level 1
+struct SetVar {
+  static constexpr Method method = Method::SetVar;
+  static constexpr std::string_view methodName = "nvim_set_var";
+  using Result = void;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 6
+struct SetVvar {
+  static constexpr Method method = Method::SetVvar;
+  static constexpr std::string_view methodName = "nvim_set_vvar";
+  using Result = void;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 1
+struct Strwidth {
+  static constexpr Method method = Method::Strwidth;
+  static constexpr std::string_view methodName = "nvim_strwidth";
+  using Result = int64_t;
+  std::string_view text;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(text);
+  }
+};
+
+// since api level 1
+struct TabpageDelVar {
+  static constexpr Method method = Method::TabpageDelVar;
+  static constexpr std::string_view methodName = "nvim_tabpage_del_var";
+  using Result = void;
+  Handle tabpage;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(tabpage);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct TabpageGetNumber {
+  static constexpr Method method = Method::TabpageGetNumber;
+  static constexpr std::string_view methodName = "nvim_tabpage_get_number";
+  using Result = int64_t;
+  Handle tabpage;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(tabpage);
+  }
+};
+
+// since api level 1
+struct TabpageGetVar {
+  static constexpr Method method = Method::TabpageGetVar;
+  static constexpr std::string_view methodName = "nvim_tabpage_get_var";
+  using Result = Object;
+  Handle tabpage;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(tabpage);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct TabpageGetWin {
+  static constexpr Method method = Method::TabpageGetWin;
+  static constexpr std::string_view methodName = "nvim_tabpage_get_win";
+  using Result = Handle;
+  Handle tabpage;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(tabpage);
+  }
+};
+
+// since api level 1
+struct TabpageIsValid {
+  static constexpr Method method = Method::TabpageIsValid;
+  static constexpr std::string_view methodName = "nvim_tabpage_is_valid";
+  using Result = bool;
+  Handle tabpage;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(tabpage);
+  }
+};
+
+// since api level 1
+struct TabpageListWins {
+  static constexpr Method method = Method::TabpageListWins;
+  static constexpr std::string_view methodName = "nvim_tabpage_list_wins";
+  using Result = std::vector<Handle>;
+  Handle tabpage;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(tabpage);
+  }
+};
+
+// since api level 1
+struct TabpageSetVar {
+  static constexpr Method method = Method::TabpageSetVar;
+  static constexpr std::string_view methodName = "nvim_tabpage_set_var";
+  using Result = void;
+  Handle tabpage;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(tabpage);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 12
+struct TabpageSetWin {
+  static constexpr Method method = Method::TabpageSetWin;
+  static constexpr std::string_view methodName = "nvim_tabpage_set_win";
+  using Result = void;
+  Handle tabpage;
+  Handle win;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(tabpage);
+    o.pack(win);
+  }
+};
+
+// since api level 1
+struct UiAttach {
+  static constexpr Method method = Method::UiAttach;
+  static constexpr std::string_view methodName = "nvim_ui_attach";
+  using Result = void;
+  int64_t width;
+  int64_t height;
+  DictRef options;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(width);
+    o.pack(height);
+    o.pack(options);
+  }
+};
+
+// since api level 1
+struct UiDetach {
+  static constexpr Method method = Method::UiDetach;
+  static constexpr std::string_view methodName = "nvim_ui_detach";
+  using Result = void;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(0);
+  }
+};
+
+// since api level 7
+struct UiPumSetBounds {
+  static constexpr Method method = Method::UiPumSetBounds;
+  static constexpr std::string_view methodName = "nvim_ui_pum_set_bounds";
+  using Result = void;
+  double width;
+  double height;
+  double row;
+  double col;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(4);
+    o.pack(width);
+    o.pack(height);
+    o.pack(row);
+    o.pack(col);
+  }
+};
+
+// since api level 6
+struct UiPumSetHeight {
+  static constexpr Method method = Method::UiPumSetHeight;
+  static constexpr std::string_view methodName = "nvim_ui_pum_set_height";
+  using Result = void;
+  int64_t height;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(height);
+  }
+};
+
+// since api level 11
+struct UiSetFocus {
+  static constexpr Method method = Method::UiSetFocus;
+  static constexpr std::string_view methodName = "nvim_ui_set_focus";
+  using Result = void;
+  bool gained;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(gained);
+  }
+};
+
+// since api level 1
+struct UiSetOption {
+  static constexpr Method method = Method::UiSetOption;
+  static constexpr std::string_view methodName = "nvim_ui_set_option";
+  using Result = void;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 12
+struct UiTermEvent {
+  static constexpr Method method = Method::UiTermEvent;
+  static constexpr std::string_view methodName = "nvim_ui_term_event";
+  using Result = void;
+  std::string_view event;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(event);
+    o.pack(value);
+  }
+};
+
+// since api level 1
+struct UiTryResize {
+  static constexpr Method method = Method::UiTryResize;
+  static constexpr std::string_view methodName = "nvim_ui_try_resize";
+  using Result = void;
+  int64_t width;
+  int64_t height;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(width);
+    o.pack(height);
+  }
+};
+
+// since api level 6
+struct UiTryResizeGrid {
+  static constexpr Method method = Method::UiTryResizeGrid;
+  static constexpr std::string_view methodName = "nvim_ui_try_resize_grid";
+  using Result = void;
+  int64_t grid;
+  int64_t width;
+  int64_t height;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(grid);
+    o.pack(width);
+    o.pack(height);
+  }
+};
+
+// since api level 6
+struct WinClose {
+  static constexpr Method method = Method::WinClose;
+  static constexpr std::string_view methodName = "nvim_win_close";
+  using Result = void;
+  Handle window;
+  bool force;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(force);
+  }
+};
+
+// since api level 1
+struct WinDelVar {
+  static constexpr Method method = Method::WinDelVar;
+  static constexpr std::string_view methodName = "nvim_win_del_var";
+  using Result = void;
+  Handle window;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct WinGetBuf {
+  static constexpr Method method = Method::WinGetBuf;
+  static constexpr std::string_view methodName = "nvim_win_get_buf";
+  using Result = Handle;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 6
+struct WinGetConfig {
+  static constexpr Method method = Method::WinGetConfig;
+  static constexpr std::string_view methodName = "nvim_win_get_config";
+  using Result = Dict;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetCursor {
+  static constexpr Method method = Method::WinGetCursor;
+  static constexpr std::string_view methodName = "nvim_win_get_cursor";
+  using Result = std::array<int64_t, 2>;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetHeight {
+  static constexpr Method method = Method::WinGetHeight;
+  static constexpr std::string_view methodName = "nvim_win_get_height";
+  using Result = int64_t;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetNumber {
+  static constexpr Method method = Method::WinGetNumber;
+  static constexpr std::string_view methodName = "nvim_win_get_number";
+  using Result = int64_t;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetPosition {
+  static constexpr Method method = Method::WinGetPosition;
+  static constexpr std::string_view methodName = "nvim_win_get_position";
+  using Result = std::array<int64_t, 2>;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetTabpage {
+  static constexpr Method method = Method::WinGetTabpage;
+  static constexpr std::string_view methodName = "nvim_win_get_tabpage";
+  using Result = Handle;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinGetVar {
+  static constexpr Method method = Method::WinGetVar;
+  static constexpr std::string_view methodName = "nvim_win_get_var";
+  using Result = Object;
+  Handle window;
+  std::string_view name;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(name);
+  }
+};
+
+// since api level 1
+struct WinGetWidth {
+  static constexpr Method method = Method::WinGetWidth;
+  static constexpr std::string_view methodName = "nvim_win_get_width";
+  using Result = int64_t;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 7
+struct WinHide {
+  static constexpr Method method = Method::WinHide;
+  static constexpr std::string_view methodName = "nvim_win_hide";
+  using Result = void;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 1
+struct WinIsValid {
+  static constexpr Method method = Method::WinIsValid;
+  static constexpr std::string_view methodName = "nvim_win_is_valid";
+  using Result = bool;
+  Handle window;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(1);
+    o.pack(window);
+  }
+};
+
+// since api level 5
+struct WinSetBuf {
+  static constexpr Method method = Method::WinSetBuf;
+  static constexpr std::string_view methodName = "nvim_win_set_buf";
+  using Result = void;
+  Handle window;
+  Handle buffer;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(buffer);
+  }
+};
+
+// since api level 6
+struct WinSetConfig {
+  static constexpr Method method = Method::WinSetConfig;
+  static constexpr std::string_view methodName = "nvim_win_set_config";
+  using Result = void;
+  Handle window;
+  DictRef config;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(config);
+  }
+};
+
+// since api level 1
+struct WinSetCursor {
+  static constexpr Method method = Method::WinSetCursor;
+  static constexpr std::string_view methodName = "nvim_win_set_cursor";
+  using Result = void;
+  Handle window;
+  std::array<int64_t, 2> pos;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(pos);
+  }
+};
+
+// since api level 1
+struct WinSetHeight {
+  static constexpr Method method = Method::WinSetHeight;
+  static constexpr std::string_view methodName = "nvim_win_set_height";
+  using Result = void;
+  Handle window;
+  int64_t height;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(height);
+  }
+};
+
+// since api level 10
+struct WinSetHlNs {
+  static constexpr Method method = Method::WinSetHlNs;
+  static constexpr std::string_view methodName = "nvim_win_set_hl_ns";
+  using Result = void;
+  Handle window;
+  int64_t nsId;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(nsId);
+  }
+};
+
+// since api level 1
+struct WinSetVar {
+  static constexpr Method method = Method::WinSetVar;
+  static constexpr std::string_view methodName = "nvim_win_set_var";
+  using Result = void;
+  Handle window;
+  std::string_view name;
+  ObjectRef value;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(3);
+    o.pack(window);
+    o.pack(name);
+    o.pack(value);
+  }
+};
+
+// since api level 1
+struct WinSetWidth {
+  static constexpr Method method = Method::WinSetWidth;
+  static constexpr std::string_view methodName = "nvim_win_set_width";
+  using Result = void;
+  Handle window;
+  int64_t width;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(width);
+  }
+};
+
+// since api level 12
+struct WinTextHeight {
+  static constexpr Method method = Method::WinTextHeight;
+  static constexpr std::string_view methodName = "nvim_win_text_height";
+  using Result = Dict;
+  Handle window;
+  DictRef opts;
+
+  template <typename Stream>
+  void msgpack_pack(msgpack::packer<Stream>& o) const {
+    o.pack_array(2);
+    o.pack(window);
+    o.pack(opts);
+  }
+};
+
+} // namespace api
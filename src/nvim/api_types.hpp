@@ -0,0 +1,86 @@
+#pragma once
+
+#include <type_traits>
+#include "msgpack.hpp"
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Types used by the generated api bindings (nvim/api.hpp).
+// Parameters are views packed straight into the request buffer,
+// results own their data.
+namespace api {
+
+// Buffer, Window or Tabpage id. nvim sends them as ext types,
+// and accepts plain integers.
+struct Handle {
+  int64_t id = 0;
+  bool operator==(const Handle&) const = default;
+};
+
+using ObjectRef = msgpack::type::variant_ref;
+using DictRef = const std::map<std::string_view, ObjectRef>&;
+using ArrayRef = const std::vector<ObjectRef>&;
+
+using Object = msgpack::type::variant;
+using Dict = std::map<std::string, Object>;
+using Array = std::vector<Object>;
+
+// std::future of a call's typed result, the response is converted by get().
+// get() throws like the untyped future (nvim error, rpc::CallAborted),
+// and msgpack::type_error if the result doesn't match.
+template <typename T>
+struct Future {
+  std::future<msgpack::object_handle> future;
+
+  bool valid() const { return future.valid(); }
+  void wait() const { future.wait(); }
+  template <typename Rep, typename Period>
+  std::future_status wait_for(const std::chrono::duration<Rep, Period>& duration) const {
+    return future.wait_for(duration);
+  }
+
+  T get() {
+    auto handle = future.get();
+    if constexpr (!std::is_void_v<T>) {
+      return handle->as<T>();
+    }
+  }
+};
+
+} // namespace api
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <>
+struct convert<api::Handle> {
+  const msgpack::object& operator()(const msgpack::object& o, api::Handle& v) const {
+    if (o.type == msgpack::type::EXT) {
+      // payload is the id packed as a msgpack integer
+      auto handle = msgpack::unpack(o.via.ext.data(), o.via.ext.size);
+      v.id = handle->as<int64_t>();
+    } else {
+      v.id = o.as<int64_t>();
+    }
+    return o;
+  }
+};
+
+template <>
+struct pack<api::Handle> {
+  template <typename Stream>
+  packer<Stream>& operator()(msgpack::packer<Stream>& o, const api::Handle& v) const {
+    o.pack(v.id);
+    return o;
+  }
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
@@ -1,15 +1,24 @@
 #include "./client.hpp"
 #include "boost/asio/connect.hpp"
+#include "boost/asio/post.hpp"
+#include "boost/asio/write.hpp"
 #include "boost/process/v1/io.hpp"
 #include "boost/process/v1/start_dir.hpp"
 #include "boost/process/start_dir.hpp"
 #include "boost/process/v1/search_path.hpp"
 #include "msgpack/v3/object_fwd_decl.hpp"
 #include "utils/logger.hpp"
+#include "utils/trace.hpp"
 #include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 namespace rpc {
 
+Client::Client(Reactor* _reactor) : reactor(_reactor) {
+}
+
 Client::~Client() {
   TryDisconnect();
 
@@ -20,6 +29,9 @@ Client::~Client() {
 
   } else if (clientType == ClientType::Tcp) {
     if (socket->is_open()) socket->close();
+
+  } else if (clientType == ClientType::UnixSocket) {
+    if (unixSocket->is_open()) unixSocket->close();
   }
 
   for (auto& thread : rwThreads) {
@@ -34,8 +46,8 @@ bool Client::ConnectStdio(
 ) {
   clientType = ClientType::Stdio;
 
-  readPipe = std::make_unique<bp::async_pipe>(context);
-  writePipe = std::make_unique<bp::async_pipe>(context);
+  readPipe = std::make_unique<bp::async_pipe>(IoContext());
+  writePipe = std::make_unique<bp::async_pipe>(IoContext());
 
   auto GetEnv = [](const char* name) -> std::string {
     char* value = std::getenv(name);
@@ -70,16 +82,14 @@ bool Client::ConnectStdio(
     return false;
   }
   exit = false;
-
-  rwThreads.emplace_back([this]() { DoRead(); });
-  rwThreads.emplace_back([this]() { DoWrite(); });
+  Start();
 
   return true;
 }
 
 bool Client::ConnectTcp(std::string_view host, uint16_t port) {
   clientType = ClientType::Tcp;
-  socket = std::make_unique<asio::ip::tcp::socket>(context);
+  socket = std::make_unique<asio::ip::tcp::socket>(IoContext());
 
   boost::system::error_code ec;
   asio::ip::tcp::resolver resolver(context);
@@ -92,16 +102,77 @@ bool Client::ConnectTcp(std::string_view host, uint16_t port) {
     return false;
   }
   exit = false;
+  Start();
+
+  return true;
+}
+
+bool Client::ConnectUnixSocket(const std::string& path) {
+  clientType = ClientType::UnixSocket;
+  unixSocket = std::make_unique<asio::local::stream_protocol::socket>(IoContext());
+
+  boost::system::error_code ec;
+  unixSocket->connect(asio::local::stream_protocol::endpoint(path), ec);
+
+  if (ec) {
+    LOG_ERR("Client::ConnectUnixSocket: {} - {}", path, ec.message());
+    unixSocket->close();
+    exit = true;
+    return false;
+  }
+  exit = false;
+  Start();
+
+  return true;
+}
+
+bool Client::ConnectReplay(const std::string& path, bool realtime) {
+  clientType = ClientType::Replay;
+  // no pipe or socket to wait on, a blocking thread is simpler
+  reactor = nullptr;
 
-  rwThreads.emplace_back([this]() { DoRead(); });
-  rwThreads.emplace_back([this]() { DoWrite(); });
+  replayer = std::make_unique<Replayer>();
+  if (!replayer->Open(path, realtime)) {
+    exit = true;
+    return false;
+  }
+  exit = false;
+  Start();
 
   return true;
 }
 
+bool Client::StartRecording(const std::string& path) {
+  return recorder.Open(path);
+}
+
+void Client::Start() {
+  if (reactor == nullptr) {
+    rwThreads.emplace_back([this]() {
+      TRACE_THREAD_NAME("rpc_read");
+      DoRead();
+    });
+    rwThreads.emplace_back([this]() {
+      TRACE_THREAD_NAME("rpc_write");
+      DoWrite();
+    });
+    return;
+  }
+
+  ReserveReadBuffer();
+  asio::post(reactor->Context(), [self = shared_from_this()] { self->AsyncRead(); });
+}
+
 void Client::TryDisconnect() {
   if (!exit.exchange(true)) {
     msgsOutCv.notify_one();
+    AbortAllCalls("disconnected");
+
+    // closing aborts the pending async ops, releasing their references
+    if (reactor == nullptr) return;
+    if (auto self = weak_from_this().lock()) {
+      asio::post(reactor->Context(), [self] { self->CloseTransport(); });
+    }
   }
 }
 
@@ -109,15 +180,19 @@ bool Client::IsConnected() {
   return !exit;
 }
 
+void Client::SetRawNotification(std::string_view method, RawNotificationHandler handler) {
+  rawMethods.emplace_back(std::string(method), std::move(handler));
+}
+
 uint32_t Client::Msgid() {
   return currId++;
 }
 
 void Client::DoRead() {
-  unpacker.reserve_buffer(readSize);
+  ReserveReadBuffer();
 
   while (IsConnected()) {
-    auto buffer = asio::buffer(unpacker.buffer(), readSize);
+    auto buffer = asio::buffer(unpacker.buffer(), readSize.load());
 
     boost::system::error_code ec;
     std::size_t length;
@@ -126,6 +201,10 @@ void Client::DoRead() {
       length = readPipe->read_some(buffer, ec);
     } else if (clientType == ClientType::Tcp) {
       length = socket->read_some(buffer, ec);
+    } else if (clientType == ClientType::UnixSocket) {
+      length = unixSocket->read_some(buffer, ec);
+    } else if (clientType == ClientType::Replay) {
+      length = replayer->ReadSome(buffer, ec);
     }
 
     if (ec) {
@@ -138,155 +217,496 @@ void Client::DoRead() {
       continue;
     }
 
-    unpacker.buffer_consumed(length);
+    OnRead(length);
+  }
+}
+
+void Client::AsyncRead() {
+  if (!IsConnected()) return;
+
+  auto buffer = asio::buffer(unpacker.buffer(), readSize.load());
+  auto handler = [self = shared_from_this()](
+                   const boost::system::error_code& ec, std::size_t length
+                 ) {
+    if (ec) {
+      if (ec == asio::error::operation_aborted) return;
+      if (ec == asio::error::eof) {
+        LOG_INFO("Client::AsyncRead: Connection closed");
+        self->TryDisconnect();
+        return;
+      }
+      LOG_ERR("Client::AsyncRead: Error - {}", ec.message());
+    } else {
+      self->OnRead(length);
+    }
+    // queue full, ResumeRead re-arms once the consumer made room
+    if (!self->pendingMessages.empty()) {
+      self->readPaused.store(true, std::memory_order_relaxed);
+      // pairs with the fence in MaybeResumeRead, the consumer may have made
+      // room before it could see the pause
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!self->PushPending()) return;
+      self->readPaused.store(false, std::memory_order_relaxed);
+    }
+    self->AsyncRead();
+  };
+
+  if (clientType == ClientType::Stdio) {
+    readPipe->async_read_some(buffer, std::move(handler));
+  } else if (clientType == ClientType::Tcp) {
+    socket->async_read_some(buffer, std::move(handler));
+  } else if (clientType == ClientType::UnixSocket) {
+    unixSocket->async_read_some(buffer, std::move(handler));
+  }
+}
+
+void Client::OnRead(std::size_t length) {
+  TRACE_SCOPE("rpc_read");
+  TRACE_COUNTER("rpc_read_bytes", length);
+  if (recorder.IsOpen()) recorder.Write({unpacker.buffer(), length});
+  unpacker.buffer_consumed(length);
+
+  // frame messages with rpc::Reader instead of unpacker.next(), so raw
+  // notifications never get unpacked into a msgpack::object tree
+  while (true) {
+    std::span<const char> bytes(unpacker.nonparsed_buffer(), unpacker.nonparsed_size());
+    Reader reader(bytes);
+    // incomplete, wait for more data and resume where this left off
+    if (!reader.TrySkip(readState)) break;
+
+    HandleMessage(bytes.first(reader.Offset()));
+    unpacker.skip_nonparsed_buffer(reader.Offset());
+  }
+
+  AdaptReadSize(length);
+  ReserveReadBuffer();
+}
+
+void Client::AdaptReadSize(std::size_t length) {
+  auto now = std::chrono::steady_clock::now();
+  size_t size = readSize.load(std::memory_order_relaxed);
+
+  if (length == size) {
+    // filled the buffer, more is likely waiting
+    lastFullRead = now;
+    if (++fullReads >= 2 && size < maxReadSize) {
+      readSize.store(size * 2, std::memory_order_relaxed);
+      fullReads = 0;
+    }
+    return;
+  }
+  fullReads = 0;
+
+  if (size > minReadSize && now - lastFullRead > shrinkDelay &&
+      unpacker.nonparsed_size() == 0) {
+    readSize.store(minReadSize, std::memory_order_relaxed);
+    // the unpacker never shrinks its buffer, start over with a small one
+    unpacker = msgpack::unpacker(nullptr, nullptr, minReadSize);
+  }
+}
+
+void Client::ReserveReadBuffer() {
+  size_t size = readSize.load(std::memory_order_relaxed);
+  if (unpacker.buffer_capacity() < size) {
+    unpacker.reserve_buffer(size);
+  }
 
-    msgpack::object_handle handle;
-    while (unpacker.next(handle)) {
-      const auto& obj = handle.get();
+  // approximate, ignores the bytes already parsed at the front
+  size_t held = unpacker.nonparsed_size() + unpacker.buffer_capacity();
+  bufferSize.store(held, std::memory_order_relaxed);
+  if (held > peakBufferSize.load(std::memory_order_relaxed)) {
+    peakBufferSize.store(held, std::memory_order_relaxed);
+  }
+}
 
-      if (obj.type != msgpack::type::ARRAY || obj.via.array.size < 3) {
-        continue;
+void Client::HandleMessage(std::span<const char> bytes) {
+  const RawMethod* rawMethod = nullptr;
+  Notification notification;
+
+  try {
+    Reader reader(bytes);
+    uint32_t size = reader.ReadArray();
+    int type = reader.ReadInt();
+
+    if (type == MessageType::Notification && size == 3) {
+      auto method = reader.ReadStr();
+      auto it = std::ranges::find(rawMethods, method, &RawMethod::method);
+      if (it != rawMethods.end()) {
+        auto params = reader.ReadRaw();
+
+        // single copy out of the read buffer, decoded later by the consumer
+        auto zone = ZonePool::Shared().Acquire();
+        auto* data =
+          static_cast<char*>(zone->allocate_no_align(method.size() + params.size()));
+        std::memcpy(data, method.data(), method.size());
+        std::memcpy(data + method.size(), params.data(), params.size());
+
+        notification = {
+          .method = {data, method.size()},
+          .rawParams = {data + method.size(), params.size()},
+          ._zone = std::move(zone),
+        };
+        rawMethod = &*it;
       }
+    }
+  } catch (const msgpack::type_error&) {
+    // not a well formed notification, let HandleObject deal with it
+  }
 
-      try {
-        int type = obj.via.array.ptr[0].convert();
-
-        if (type == MessageType::Request) {
-          RequestIn request(obj.convert());
-          {
-            auto msgsAccess = messages.lock();
-            auto& message = msgsAccess->emplace(Request{
-              .method = request.method,
-              .params = request.params,
-              ._zone = std::move(handle.zone()),
-              .promise{},
-            });
-            auto& promise = std::get<Request>(message).promise;
-
-            std::thread([weak_self = weak_from_this(), msgid = request.msgid,
-                         future = promise.get_future()] mutable {
-              try {
-                ResponseOut msg{.msgid = msgid};
-
-                // result holds memory zone, it should be in scope when 
-                // packing the response
-                RequestResult result = future.get();
-                if (result) {
-                  msg.result = (*result).get();
-                } else {
-                  msg.error = result.error().get();
-                }
-
-                msgpack::sbuffer buffer;
-                msgpack::pack(buffer, msg);
-
-                if (auto self = weak_self.lock()) {
-                  self->Write(std::move(buffer));
-                }
-
-              } catch (...) {
-                // Future broken (session destroyed), safe to ignore
-                return;
-              }
-            }).detach();
-          }
+  if (rawMethod != nullptr) {
+    if (rawMethod->handler) {
+      rawMethod->handler(std::move(notification));
+    } else {
+      PushMessage(std::move(notification));
+    }
+    return;
+  }
 
-        } else if (type == MessageType::Response) {
-          ResponseIn response(obj.convert());
-          {
-            std::scoped_lock lock(responsesMutex);
-
-            if (auto it = responses.find(response.msgid); it != responses.end()) {
-              auto& promise = it->second;
-              if (response.error.is_nil()) {
-                promise.set_value(
-                  msgpack::object_handle(response.result, std::move(handle.zone()))
-                );
-              } else {
-                // nvim error format: [error_type, error_message]
-                std::string errMsg;
-                if (response.error.type == msgpack::type::ARRAY &&
-                    response.error.via.array.size >= 2 &&
-                    response.error.via.array.ptr[1].type == msgpack::type::STR) {
-                  auto& str = response.error.via.array.ptr[1].via.str;
-                  errMsg = std::string(str.ptr, str.size);
-
-                  // Strip "Lua: " prefix
-                  if (errMsg.starts_with("Lua: ")) {
-                    errMsg = errMsg.substr(5);
-                  }
-                  // Remove stack traceback
-                  if (auto pos = errMsg.find("\nstack traceback:"); pos != std::string::npos) {
-                    errMsg = errMsg.substr(0, pos);
-                  }
-                } else {
-                  errMsg = ToString(response.error);
-                }
-                promise.set_exception(std::make_exception_ptr(std::runtime_error(errMsg)));
-              }
-              responses.erase(it);
-
-            } else {
-              LOG_ERR(
-                "Client::DoRead: Response not found for msgid: {}", response.msgid
-              );
-            }
-          }
+  try {
+    auto zone = ZonePool::Shared().Acquire();
+    std::size_t offset = 0;
+    auto obj = msgpack::unpack(*zone, bytes.data(), bytes.size(), offset);
+    HandleObject(obj, std::move(zone));
+  } catch (const msgpack::unpack_error& e) {
+    LOG_ERR("Client::HandleMessage: msgpack::unpack_error - {}", e.what());
+  }
+}
+
+void Client::HandleObject(const msgpack::object& obj, PooledZone zone) {
+  if (obj.type != msgpack::type::ARRAY || obj.via.array.size < 3) {
+    return;
+  }
 
-        } else if (type == MessageType::Notification) {
-          NotificationIn notification(obj.convert());
-          messages.lock()->emplace(Notification{
-            .method = notification.method,
-            .params = notification.params,
-            ._zone = std::move(handle.zone()),
-          });
+  try {
+    int type = obj.via.array.ptr[0].convert();
+
+    if (type == MessageType::Request) {
+      RequestIn request(obj.convert());
+      PushMessage(Request{
+        .method = request.method,
+        .params = request.params,
+        ._zone = std::move(zone),
+        .responder{request.msgid, weak_from_this()},
+      });
 
+    } else if (type == MessageType::Response) {
+      ResponseIn response(obj.convert());
+
+      auto call = responses.Take(response.msgid);
+      if (!call) {
+        // aborted calls (timeout, cancel) end up here too,
+        // and recorded responses when replaying
+        if (clientType != ClientType::Replay) {
+          LOG_WARN(
+            "Client::HandleObject: Response not found for msgid: {}", response.msgid
+          );
+        }
+        return;
+      }
+      if (call->timer != 0) TimerWheel::Shared().Cancel(call->timer);
+
+      auto& promise = call->promise;
+      if (response.error.is_nil()) {
+        // scalar results (nvim_input, most setters) don't point into the zone.
+        // the rest is copied into a zone of its own, object_handle can't hand
+        // a pooled zone back to the pool
+        switch (response.result.type) {
+          case msgpack::type::NIL:
+          case msgpack::type::BOOLEAN:
+          case msgpack::type::POSITIVE_INTEGER:
+          case msgpack::type::NEGATIVE_INTEGER:
+          case msgpack::type::FLOAT32:
+          case msgpack::type::FLOAT64:
+            promise.set_value(msgpack::object_handle(response.result, nullptr));
+            break;
+          default: promise.set_value(msgpack::clone(response.result));
+        }
+      } else {
+        // nvim error format: [error_type, error_message]
+        std::string errMsg;
+        if (response.error.type == msgpack::type::ARRAY &&
+            response.error.via.array.size >= 2 &&
+            response.error.via.array.ptr[1].type == msgpack::type::STR) {
+          auto& str = response.error.via.array.ptr[1].via.str;
+          errMsg = std::string(str.ptr, str.size);
+
+          // Strip "Lua: " prefix
+          if (errMsg.starts_with("Lua: ")) {
+            errMsg = errMsg.substr(5);
+          }
+          // Remove stack traceback
+          if (auto pos = errMsg.find("\nstack traceback:"); pos != std::string::npos) {
+            errMsg = errMsg.substr(0, pos);
+          }
         } else {
-          LOG_WARN("Client::DoRead: Unknown type: {}", type);
+          errMsg = ToString(response.error);
         }
-
-      } catch (msgpack::type_error& e) {
-        LOG_ERR("Client::DoRead: msgpack::type_error - {}", e.what());
+        promise.set_exception(std::make_exception_ptr(std::runtime_error(errMsg)));
       }
+
+    } else if (type == MessageType::Notification) {
+      NotificationIn notification(obj.convert());
+      PushMessage(Notification{
+        .method = notification.method,
+        .params = notification.params,
+        ._zone = std::move(zone),
+      });
+
+    } else {
+      LOG_WARN("Client::HandleObject: Unknown type: {}", type);
     }
 
-    if (unpacker.buffer_capacity() < readSize) {
-      unpacker.reserve_buffer(readSize);
+  } catch (msgpack::type_error& e) {
+    LOG_ERR("Client::HandleObject: msgpack::type_error - {}", e.what());
+  }
+}
+
+void Client::Respond(
+  uint32_t msgid, const msgpack::object& error, const msgpack::object& result
+) {
+  if (!IsConnected()) return;
+
+  ResponseOut msg{
+    .msgid = msgid,
+    .error = error,
+    .result = result,
+  };
+  auto buffer = BufferPool::Shared().Acquire();
+  msgpack::pack(buffer, msg);
+  Write(std::move(buffer));
+}
+
+Responder::~Responder() {
+  if (client.expired()) return;
+  auto zone = ZonePool::Shared().Acquire();
+  (*this)(msgpack::object("Request dropped", *zone), {});
+}
+
+void Responder::operator()(const msgpack::object& error, const msgpack::object& result) {
+  // moved from or already responded
+  if (auto self = std::exchange(client, {}).lock()) {
+    self->Respond(msgid, error, result);
+  }
+}
+
+void Client::WatchCall(uint32_t msgid, const CallOptions& opts) {
+  bool hasTimeout = opts.timeout.count() > 0;
+  bool hasStop = opts.stopToken.stop_possible();
+  if (!hasTimeout && !hasStop) return;
+
+  // callbacks only hold a weak reference, they may outlive the client
+  auto abort = [weak_self = weak_from_this(), msgid](std::string_view reason) {
+    if (auto self = weak_self.lock()) self->AbortCall(msgid, reason);
+  };
+
+  TimerWheel::Id timer = 0;
+  if (hasTimeout) {
+    timer = TimerWheel::Shared().Schedule(opts.timeout, [abort] { abort("timed out"); });
+  }
+  // runs inline if stop was already requested
+  std::unique_ptr<ResponseTable::StopCallback> onStop;
+  if (hasStop) {
+    onStop = std::make_unique<ResponseTable::StopCallback>(
+      opts.stopToken, [abort] { abort("cancelled"); }
+    );
+  }
+
+  if (responses.Attach(msgid, timer, onStop)) return;
+  // already completed
+  if (timer != 0) TimerWheel::Shared().Cancel(timer);
+}
+
+void Client::AbortCall(uint32_t msgid, std::string_view reason) {
+  auto call = responses.Take(msgid);
+  if (!call) return;
+  if (call->timer != 0) TimerWheel::Shared().Cancel(call->timer);
+  call->promise.set_exception(std::make_exception_ptr(
+    CallAborted(std::format("Call {} {}", msgid, reason))
+  ));
+}
+
+void Client::AbortAllCalls(std::string_view reason) {
+  for (auto& [msgid, call] : responses.TakeAll()) {
+    if (call.timer != 0) TimerWheel::Shared().Cancel(call.timer);
+    call.promise.set_exception(std::make_exception_ptr(
+      CallAborted(std::format("Call {} {}", msgid, reason))
+    ));
+  }
+}
+
+void Client::PushMessage(Message&& message) {
+  // behind the ones already waiting, to keep the order
+  if (pendingMessages.empty() && messages.TryPush(std::move(message))) return;
+
+  if (reactor != nullptr) {
+    // the reactor is shared by every session, don't wait on it. the message
+    // is kept and AsyncRead isn't re-armed until the consumer makes room
+    if (pendingMessages.empty()) {
+      messageQueueWaits.fetch_add(1, std::memory_order_relaxed);
+      LOG_WARN("Client::PushMessage: message queue full ({})", messages.Capacity());
     }
+    pendingMessages.push_back(std::move(message));
+    return;
+  }
+
+  // render thread fell behind, wait for it instead of dropping messages
+  messageQueueWaits.fetch_add(1, std::memory_order_relaxed);
+  LOG_WARN("Client::PushMessage: message queue full ({})", messages.Capacity());
+  while (!messages.TryPush(std::move(message))) {
+    if (!IsConnected()) return;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
   }
 }
 
-void Client::Write(msgpack::sbuffer&& buffer) {
-  msgsOut.lock()->push(std::move(buffer));
-  msgsOutCv.notify_one();
+// consumer thread, after popping
+void Client::QueueResumeRead() {
+  if (resumeQueued.exchange(true, std::memory_order_acq_rel)) return;
+  asio::post(reactor->Context(), [self = shared_from_this()] { self->ResumeRead(); });
+}
+
+// reactor thread, returns true once every waiting message is queued
+bool Client::PushPending() {
+  while (!pendingMessages.empty() && messages.TryPush(std::move(pendingMessages.front()))) {
+    pendingMessages.pop_front();
+  }
+  return pendingMessages.empty();
+}
+
+// reactor thread
+void Client::ResumeRead() {
+  resumeQueued.store(false, std::memory_order_relaxed);
+  // a pop that saw resumeQueued still set must be visible to PushPending
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // already resumed (queued twice), or still full and the next pop tries again
+  if (!readPaused.load(std::memory_order_relaxed) || !PushPending()) return;
+
+  readPaused.store(false, std::memory_order_relaxed);
+  AsyncRead();
+}
+
+void Client::Write(msgpack::sbuffer&& buffer, bool priority) {
+  bool startWrite = false;
+  {
+    auto access = msgsOut.lock();
+    auto& lane = priority ? access->priority : access->normal;
+    lane.push_back(std::move(buffer));
+    if (reactor != nullptr) startWrite = !std::exchange(writing, true);
+  }
+
+  if (reactor == nullptr) {
+    msgsOutCv.notify_one();
+  } else if (startWrite) {
+    asio::post(reactor->Context(), [self = shared_from_this()] { self->AsyncWrite(); });
+  }
+}
+
+// called with msgsOut's lock held, messages are never split
+void Client::TakeWrites(OutQueue& queue, std::vector<msgpack::sbuffer>& out) {
+  for (auto& msgBuffer : queue.priority) {
+    out.push_back(std::move(msgBuffer));
+  }
+  queue.priority.clear();
+
+  size_t size = 0;
+  auto it = queue.normal.begin();
+  for (; it != queue.normal.end(); it++) {
+    // a single message bigger than the limit still goes out whole
+    if (it != queue.normal.begin() && size + it->size() > maxNormalWrite) break;
+    size += it->size();
+    out.push_back(std::move(*it));
+  }
+  queue.normal.erase(queue.normal.begin(), it);
 }
 
 void Client::DoWrite() {
+  std::vector<msgpack::sbuffer> pending;
+  std::vector<asio::const_buffer> buffers;
+
   while (true) {
     {
       auto access = msgsOut.lock();
       msgsOutCv.wait(access.get_lock(), [&] {
-        return !access->empty() || exit;
+        return !access->Empty() || exit;
       });
+      TakeWrites(*access, pending);
     }
     if (!IsConnected()) break;
 
-    auto& msgBuffer = msgsOut.lock()->front();
-    auto buffer = asio::buffer(msgBuffer.data(), msgBuffer.size());
+    TRACE_SCOPE("rpc_write");
+    TRACE_COUNTER("rpc_write_messages", pending.size());
+    buffers.clear();
+    for (auto& msgBuffer : pending) {
+      buffers.emplace_back(msgBuffer.data(), msgBuffer.size());
+    }
 
+    // gathered write, loops until every byte is written
     boost::system::error_code ec;
-
     if (clientType == ClientType::Stdio) {
-      writePipe->write_some(buffer, ec);
+      asio::write(*writePipe, buffers, ec);
     } else if (clientType == ClientType::Tcp) {
-      socket->write_some(buffer, ec);
+      asio::write(*socket, buffers, ec);
+    } else if (clientType == ClientType::UnixSocket) {
+      asio::write(*unixSocket, buffers, ec);
     }
 
     if (ec) {
       LOG_ERR("Client::DoWrite: {}", ec.message());
     }
 
-    msgsOut.lock()->pop();
+    for (auto& msgBuffer : pending) {
+      BufferPool::Shared().Release(std::move(msgBuffer));
+    }
+    pending.clear();
+  }
+}
+
+void Client::AsyncWrite() {
+  {
+    auto access = msgsOut.lock();
+    if (access->Empty() || !IsConnected()) {
+      writing = false;
+      return;
+    }
+    TakeWrites(*access, writesPending);
+  }
+
+  writeBuffers.clear();
+  for (auto& msgBuffer : writesPending) {
+    writeBuffers.emplace_back(msgBuffer.data(), msgBuffer.size());
+  }
+
+  auto handler = [self = shared_from_this()](
+                   const boost::system::error_code& ec, std::size_t
+                 ) {
+    if (ec && ec != asio::error::operation_aborted) {
+      LOG_ERR("Client::AsyncWrite: {}", ec.message());
+    }
+    for (auto& msgBuffer : self->writesPending) {
+      BufferPool::Shared().Release(std::move(msgBuffer));
+    }
+    self->writesPending.clear();
+    // picks up what was queued while this write was in flight
+    self->AsyncWrite();
+  };
+
+  if (clientType == ClientType::Stdio) {
+    asio::async_write(*writePipe, writeBuffers, std::move(handler));
+  } else if (clientType == ClientType::Tcp) {
+    asio::async_write(*socket, writeBuffers, std::move(handler));
+  } else if (clientType == ClientType::UnixSocket) {
+    asio::async_write(*unixSocket, writeBuffers, std::move(handler));
+  }
+}
+
+void Client::CloseTransport() {
+  boost::system::error_code ec;
+  if (clientType == ClientType::Stdio) {
+    readPipe->close(ec);
+    writePipe->close(ec);
+  } else if (clientType == ClientType::Tcp) {
+    socket->close(ec);
+  } else if (clientType == ClientType::UnixSocket) {
+    unixSocket->close(ec);
   }
 }
 
@@ -2,41 +2,61 @@
 
 #include "./message_internal.hpp"
 #include "./message.hpp"
+#include "./reader.hpp"
+#include "./reactor.hpp"
+#include "./response_table.hpp"
+#include "./pool.hpp"
+#include "./recording.hpp"
 
 #include <type_traits>
 #include "msgpack.hpp"
 
 #include "boost/asio/io_context.hpp"
 #include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/local/stream_protocol.hpp"
 #include "boost/process/v1/async_pipe.hpp"
 #include "boost/process/v1/child.hpp"
 
 #include "msgpack/v3/object_decl.hpp"
 #include "utils/thread.hpp"
+#include "utils/spsc_queue.hpp"
+#include "utils/timer_wheel.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <string_view>
-#include <unordered_map>
+#include <functional>
 #include <future>
 #include <thread>
 #include <expected>
 #include <queue>
+#include <vector>
+#include <span>
+#include <stop_token>
 
 namespace rpc {
 
 namespace bp = boost::process::v1;
 namespace asio = boost::asio;
 
+using RawNotificationHandler = std::function<void(Notification&&)>;
+
 enum class ClientType {
   Unknown,
   Stdio,
   Tcp,
+  UnixSocket,
+  Replay, // reads a recording, writes are dropped
 };
 
 struct Client : std::enable_shared_from_this<Client> {
 private:
   asio::io_context context;
+  // if set, reads and writes run async on the reactor's thread
+  // instead of the blocking rwThreads
+  Reactor* reactor = nullptr;
 
   ClientType clientType = ClientType::Unknown;
 
@@ -48,16 +68,41 @@ private:
   // tcp
   std::unique_ptr<asio::ip::tcp::socket> socket;
 
+  // unix socket
+  std::unique_ptr<asio::local::stream_protocol::socket> unixSocket;
+
+  // replay
+  std::unique_ptr<Replayer> replayer;
+
+  // written by the reader if recording
+  Recorder recorder;
+
   std::vector<std::jthread> rwThreads;
   std::atomic_bool exit;
 
-  std::unordered_map<u_int32_t, std::promise<msgpack::object_handle>> responses;
-  std::mutex responsesMutex;
+  // pending calls by msgid, completed lock-free by the reader
+  ResponseTable responses;
 
-  Sync<std::queue<Message>> messages;
+  // filled by the read thread (or reactor), consumed by the render thread
+  SpscQueue<Message> messages{1024};
+  // times PushMessage found the queue full and waited, once per wait
+  std::atomic_size_t messageQueueWaits = 0;
+  // reactor mode: messages that didn't fit, reads stop until the consumer
+  // makes room, so a full queue never blocks the shared reactor thread.
+  // pendingMessages is only touched on the reactor thread.
+  std::deque<Message> pendingMessages;
+  std::atomic_bool readPaused = false;
+  std::atomic_bool resumeQueued = false;
+
+  // notification methods that skip the msgpack::object tree
+  struct RawMethod {
+    std::string method;
+    RawNotificationHandler handler;
+  };
+  std::vector<RawMethod> rawMethods;
 
 public:
-  Client() = default;
+  explicit Client(Reactor* reactor = nullptr);
   Client(const Client&) = delete;
   Client& operator=(const Client&) = delete;
   ~Client();
@@ -66,50 +111,182 @@ public:
     const std::string& command, bool interactive, const std::string& dir = {}
   );
   bool ConnectTcp(std::string_view host, uint16_t port);
+  // path of a running nvim's --listen socket
+  bool ConnectUnixSocket(const std::string& path);
+  // feeds a recording made with StartRecording through the reader,
+  // at the recorded pace if realtime, else as fast as possible.
+  // Always uses its own threads, disconnects at the end of the recording.
+  bool ConnectReplay(const std::string& path, bool realtime = false);
+
+  // records everything read from nvim to path, call before connecting
+  bool StartRecording(const std::string& path);
+
+  // notifications with this method are queued with their raw msgpack params
+  // (Notification::rawParams), call before connecting.
+  // If handler is set, it's called on the reader thread instead of queuing.
+  void SetRawNotification(std::string_view method, RawNotificationHandler handler = {});
 
   // public functions below are thread-safe
   void TryDisconnect();
   bool IsConnected();
 
   std::future<msgpack::object_handle> Call(std::string_view func_name, auto... args);
+  // future throws CallAborted on timeout, cancellation or disconnect
+  std::future<msgpack::object_handle>
+  Call(const CallOptions& opts, std::string_view func_name, auto... args);
+  // calls a function of the generated api bindings (nvim/api.hpp),
+  // its fields are packed as the params without building a tuple
+  template <typename Fn>
+    requires requires { Fn::methodName; }
+  std::future<msgpack::object_handle> Call(const CallOptions& opts, const Fn& fn);
   void Send(std::string_view func_name, auto... args);
+  void Respond(uint32_t msgid, const msgpack::object& error, const msgpack::object& result);
 
-  bool HasMessage() { return !messages.lock()->empty(); }
-  Message& FrontMessage() { return messages.lock()->front(); }
-  void PopMessage() { messages.lock()->pop(); }
+  // message queue functions below must be called from a single consumer thread
+  bool HasMessage() { return messages.Front() != nullptr; }
+  Message& FrontMessage() { return *messages.Front(); }
+  void PopMessage() {
+    messages.Pop();
+    MaybeResumeRead();
+  }
+  // calls func on every queued message in order and pops them,
+  // returns the number of messages
+  size_t DrainMessages(auto&& func) {
+    size_t count = messages.Drain(func);
+    MaybeResumeRead();
+    return count;
+  }
+
+  struct QueueStats {
+    size_t depth;
+    size_t maxDepth; // high water mark
+    size_t fullCount; // times the reader had to wait for the consumer
+  };
+  QueueStats MessageQueueStats() const {
+    return {
+      messages.Size(), messages.MaxDepth(),
+      messageQueueWaits.load(std::memory_order_relaxed),
+    };
+  }
+
+  // thread-safe
+  struct ReadStats {
+    size_t readSize; // bytes asked for per read
+    size_t bufferSize; // bytes held by the read buffer
+    size_t peakBufferSize;
+  };
+  ReadStats ReadBufferStats() const {
+    return {
+      readSize.load(std::memory_order_relaxed),
+      bufferSize.load(std::memory_order_relaxed),
+      peakBufferSize.load(std::memory_order_relaxed),
+    };
+  }
+
+  // outgoing messages, each write takes every priority message first,
+  // then normal ones up to maxNormalWrite bytes (at least one), so input
+  // queued behind a large backlog goes out with the next write
+  struct OutQueue {
+    std::vector<msgpack::sbuffer> priority;
+    std::vector<msgpack::sbuffer> normal;
+    bool Empty() const { return priority.empty() && normal.empty(); }
+  };
+  static constexpr std::size_t maxNormalWrite = 64 << 10;
+  // moves the buffers of the next write into out
+  static void TakeWrites(OutQueue& queue, std::vector<msgpack::sbuffer>& out);
 
 private:
-  msgpack::unpacker unpacker;
-  static constexpr std::size_t readSize = 1024 << 10;
-  Sync<std::queue<msgpack::sbuffer>> msgsOut;
+  // read size starts small, doubles after consecutive reads that fill it
+  // (big redraws) and drops back once reads stay small for a while
+  static constexpr std::size_t minReadSize = 32 << 10;
+  static constexpr std::size_t maxReadSize = 4 << 20;
+  static constexpr auto shrinkDelay = std::chrono::seconds(2);
+  msgpack::unpacker unpacker{nullptr, nullptr, minReadSize};
+  // framing progress of the incomplete message at the front of the unpacker
+  Reader::SkipState readState;
+  std::atomic_size_t readSize = minReadSize;
+  int fullReads = 0;
+  std::chrono::steady_clock::time_point lastFullRead;
+  std::atomic_size_t bufferSize = 0;
+  std::atomic_size_t peakBufferSize = 0;
+  Sync<OutQueue> msgsOut;
   std::condition_variable msgsOutCv;
   std::atomic_uint32_t currId = 0;
 
+  // reactor mode, guarded by msgsOut's lock
+  bool writing = false;
+  // reactor mode, only touched on the reactor thread
+  std::vector<msgpack::sbuffer> writesPending;
+  std::vector<asio::const_buffer> writeBuffers;
+
+  asio::io_context& IoContext() { return reactor ? reactor->Context() : context; }
+  void Start();
+  void CloseTransport();
+
   uint32_t Msgid();
+  // params must pack as a msgpack array
+  std::future<msgpack::object_handle>
+  CallWith(const CallOptions& opts, std::string_view func_name, const auto& params);
+  void WatchCall(uint32_t msgid, const CallOptions& opts);
+  void AbortCall(uint32_t msgid, std::string_view reason);
+  void AbortAllCalls(std::string_view reason);
+  void PushMessage(Message&& message);
+  bool PushPending();
+  void MaybeResumeRead() {
+    // pairs with the fence in AsyncRead, either the reactor sees the room
+    // made here or this sees the pause
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (readPaused.load(std::memory_order_relaxed)) QueueResumeRead();
+  }
+  void QueueResumeRead();
+  void ResumeRead();
   void DoRead();
-  void Write(msgpack::sbuffer&& buffer);
+  void AsyncRead();
+  void OnRead(std::size_t length);
+  void AdaptReadSize(std::size_t length);
+  void ReserveReadBuffer();
+  void HandleMessage(std::span<const char> bytes);
+  void HandleObject(const msgpack::object& obj, PooledZone zone);
+  void Write(msgpack::sbuffer&& buffer, bool priority = false);
   void DoWrite();
+  void AsyncWrite();
 };
 
 std::future<msgpack::object_handle>
 Client::Call(std::string_view func_name, auto... args) {
+  return Call(CallOptions{}, func_name, args...);
+}
+
+std::future<msgpack::object_handle>
+Client::Call(const CallOptions& opts, std::string_view func_name, auto... args) {
+  return CallWith(opts, func_name, std::tuple(args...));
+}
+
+template <typename Fn>
+  requires requires { Fn::methodName; }
+std::future<msgpack::object_handle> Client::Call(const CallOptions& opts, const Fn& fn) {
+  return CallWith(opts, Fn::methodName, fn);
+}
+
+std::future<msgpack::object_handle> Client::CallWith(
+  const CallOptions& opts, std::string_view func_name, const auto& params
+) {
   if (!IsConnected()) return {};
 
-  RequestOut msg{
+  RequestOut<decltype(params)> msg{
     .msgid = Msgid(),
     .method = func_name,
-    .params = std::tuple(args...),
+    .params = params,
   };
-  msgpack::sbuffer buffer;
+  auto buffer = BufferPool::Shared().Acquire();
   msgpack::pack(buffer, msg);
-  Write(std::move(buffer));
 
   std::promise<msgpack::object_handle> promise;
   auto future = promise.get_future();
-  {
-    std::scoped_lock lock(responsesMutex);
-    responses[msg.msgid] = std::move(promise);
-  }
+  // register before writing, so a fast response always finds it
+  responses.Register(msg.msgid, std::move(promise));
+  Write(std::move(buffer), opts.priority);
+  WatchCall(msg.msgid, opts);
 
   return future;
 }
@@ -122,7 +299,7 @@ void Client::Send(std::string_view func_name, auto... args) {
     .method = func_name,
     .params = std::tuple(args...),
   };
-  msgpack::sbuffer buffer;
+  auto buffer = BufferPool::Shared().Acquire();
   msgpack::pack(buffer, msg);
   Write(std::move(buffer));
 }
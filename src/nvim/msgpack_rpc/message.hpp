@@ -2,36 +2,78 @@
 
 #include <type_traits>
 #include "msgpack.hpp"
-#include <expected>
-#include <future>
+#include "./pool.hpp"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <span>
 
 namespace rpc {
 
-using RequestResult = std::expected<msgpack::object_handle, msgpack::object_handle>;
+struct Client;
+
+struct CallOptions {
+  // no deadline if zero
+  std::chrono::milliseconds timeout{0};
+  // the call fails when stop is requested
+  std::stop_token stopToken;
+  // written ahead of already queued normal messages (keyboard and mouse input)
+  bool priority = false;
+};
+
+// set on a call's future if it timed out, was cancelled, or the client
+// disconnected before the response arrived
+struct CallAborted : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+// Sends the response of an incoming request.
+// The response is packed on the calling thread and queued on the client's
+// writer, so no thread is needed per request. Sends an error response if
+// destroyed without responding, so nvim doesn't block on a dropped request.
+struct Responder {
+  uint32_t msgid = 0;
+  std::weak_ptr<Client> client;
+
+  Responder() = default;
+  Responder(uint32_t _msgid, std::weak_ptr<Client> _client)
+      : msgid(_msgid), client(std::move(_client)) {
+  }
+  Responder(const Responder&) = delete;
+  Responder& operator=(const Responder&) = delete;
+  Responder(Responder&&) = default;
+  Responder& operator=(Responder&&) = default;
+  ~Responder();
+
+  // can be called from any thread, only the first call sends
+  void operator()(const msgpack::object& error, const msgpack::object& result);
+};
 
 struct Request {
   std::string_view method;
   msgpack::object params;
-  msgpack::unique_ptr<msgpack::zone> _zone; // holds the lifetime of the data
-  std::promise<RequestResult> promise;
+  PooledZone _zone; // holds the lifetime of the data
+  Responder responder;
 
   void SetResult(const auto& result) {
-    auto zone = std::make_unique<msgpack::zone>();
-    msgpack::object obj(result, *zone);
-    promise.set_value(msgpack::object_handle(obj, std::move(zone)));
+    auto zone = ZonePool::Shared().Acquire();
+    responder({}, msgpack::object(result, *zone));
   }
 
   void SetError(const auto& error) {
-    auto zone = std::make_unique<msgpack::zone>();
-    msgpack::object obj(error, *zone);
-    promise.set_value(std::unexpected(msgpack::object_handle(obj, std::move(zone))));
+    auto zone = ZonePool::Shared().Acquire();
+    responder(msgpack::object(error, *zone), {});
   }
 };
 
 struct Notification {
   std::string_view method;
   msgpack::object params;
-  msgpack::unique_ptr<msgpack::zone> _zone; // holds the lifetime of the data
+  // raw msgpack bytes of params, only set for methods registered with
+  // Client::SetRawNotification (params is nil then)
+  std::span<const char> rawParams;
+  PooledZone _zone; // holds the lifetime of the data
 };
 
 using Message = std::variant<Request, Notification>;
@@ -0,0 +1,118 @@
+#include "./pool.hpp"
+
+namespace rpc {
+
+// ZonePool -----------------------------------------------
+void ZonePool::Deleter::operator()(msgpack::zone* zone) const {
+  if (pool != nullptr) {
+    pool->Release(zone);
+  } else {
+    delete zone;
+  }
+}
+
+ZonePool::ZonePool(size_t _maxSize) : maxSize(_maxSize) {
+  // reserved up front, so releasing never allocates
+  zones.reserve(maxSize);
+}
+
+ZonePool::~ZonePool() {
+  for (auto* zone : zones) delete zone;
+}
+
+ZonePool::Ptr ZonePool::Acquire() {
+  acquired.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::scoped_lock lock(mutex);
+    if (!zones.empty()) {
+      auto* zone = zones.back();
+      zones.pop_back();
+      return Ptr(zone, {this});
+    }
+  }
+  created.fetch_add(1, std::memory_order_relaxed);
+  return Ptr(new msgpack::zone(), {this});
+}
+
+void ZonePool::Release(msgpack::zone* zone) {
+  // runs finalizers and frees every chunk but the first
+  zone->clear();
+  {
+    std::scoped_lock lock(mutex);
+    if (zones.size() < maxSize) {
+      zones.push_back(zone);
+      recycled.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  dropped.fetch_add(1, std::memory_order_relaxed);
+  delete zone;
+}
+
+PoolStats ZonePool::Stats() const {
+  return {
+    acquired.load(std::memory_order_relaxed),
+    created.load(std::memory_order_relaxed),
+    recycled.load(std::memory_order_relaxed),
+    dropped.load(std::memory_order_relaxed),
+  };
+}
+
+ZonePool& ZonePool::Shared() {
+  static auto* pool = new ZonePool();
+  return *pool;
+}
+
+// BufferPool -----------------------------------------------
+BufferPool::BufferPool(size_t _maxSize, size_t _maxBufferSize)
+    : maxSize(_maxSize), maxBufferSize(_maxBufferSize) {
+  buffers.reserve(maxSize);
+}
+
+msgpack::sbuffer BufferPool::Acquire() {
+  acquired.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::scoped_lock lock(mutex);
+    if (!buffers.empty()) {
+      auto buffer = std::move(buffers.back());
+      buffers.pop_back();
+      return buffer;
+    }
+  }
+  created.fetch_add(1, std::memory_order_relaxed);
+  return msgpack::sbuffer();
+}
+
+void BufferPool::Release(msgpack::sbuffer&& buffer) {
+  // sbuffer doesn't expose its capacity, size is a lower bound
+  if (buffer.data() == nullptr || buffer.size() > maxBufferSize) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.clear();
+  {
+    std::scoped_lock lock(mutex);
+    if (buffers.size() < maxSize) {
+      buffers.push_back(std::move(buffer));
+      recycled.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+PoolStats BufferPool::Stats() const {
+  return {
+    acquired.load(std::memory_order_relaxed),
+    created.load(std::memory_order_relaxed),
+    recycled.load(std::memory_order_relaxed),
+    dropped.load(std::memory_order_relaxed),
+  };
+}
+
+BufferPool& BufferPool::Shared() {
+  static auto* pool = new BufferPool();
+  return *pool;
+}
+
+} // namespace rpc
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <type_traits>
+#include "msgpack.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rpc {
+
+// counters of a pool, created counts trips to the global allocator,
+// so it stays flat once traffic reaches a steady state
+struct PoolStats {
+  size_t acquired; // taken from the pool
+  size_t created; // pool was empty, allocated a new one
+  size_t recycled; // returned and kept for reuse
+  size_t dropped; // returned but freed (pool full or too big)
+  MSGPACK_DEFINE_MAP(acquired, created, recycled, dropped);
+};
+
+// Cleared msgpack zones for incoming messages.
+// A cleared zone keeps its first chunk, so messages that fit in it
+// don't allocate. Zones are returned when a PooledZone is destroyed,
+// on whichever thread that happens.
+class ZonePool {
+public:
+  struct Deleter {
+    ZonePool* pool = nullptr; // deleted normally if null
+    void operator()(msgpack::zone* zone) const;
+  };
+  using Ptr = std::unique_ptr<msgpack::zone, Deleter>;
+
+  explicit ZonePool(size_t maxSize = 64);
+  ZonePool(const ZonePool&) = delete;
+  ZonePool& operator=(const ZonePool&) = delete;
+  ~ZonePool();
+
+  Ptr Acquire();
+  PoolStats Stats() const;
+
+  // process wide pool, never destroyed, zones may outlive main
+  static ZonePool& Shared();
+
+private:
+  std::mutex mutex;
+  std::vector<msgpack::zone*> zones;
+  size_t maxSize;
+
+  std::atomic_size_t acquired = 0;
+  std::atomic_size_t created = 0;
+  std::atomic_size_t recycled = 0;
+  std::atomic_size_t dropped = 0;
+
+  void Release(msgpack::zone* zone);
+};
+
+using PooledZone = ZonePool::Ptr;
+
+// Outgoing message buffers, returned by the writer once they're sent.
+// Cleared buffers keep their capacity.
+class BufferPool {
+public:
+  explicit BufferPool(size_t maxSize = 64, size_t maxBufferSize = 1 << 20);
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  msgpack::sbuffer Acquire();
+  void Release(msgpack::sbuffer&& buffer);
+  PoolStats Stats() const;
+
+  static BufferPool& Shared();
+
+private:
+  std::mutex mutex;
+  std::vector<msgpack::sbuffer> buffers;
+  size_t maxSize;
+  size_t maxBufferSize;
+
+  std::atomic_size_t acquired = 0;
+  std::atomic_size_t created = 0;
+  std::atomic_size_t recycled = 0;
+  std::atomic_size_t dropped = 0;
+};
+
+} // namespace rpc
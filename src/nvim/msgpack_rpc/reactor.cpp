@@ -0,0 +1,32 @@
+#include "./reactor.hpp"
+#include "utils/logger.hpp"
+#include "utils/trace.hpp"
+
+namespace rpc {
+
+Reactor::Reactor() : work(asio::make_work_guard(context)) {
+  thread = std::jthread([this] {
+    TRACE_THREAD_NAME("rpc_reactor");
+    while (true) {
+      try {
+        context.run();
+        break;
+      } catch (const std::exception& e) {
+        // one client's handler shouldn't take down the others
+        LOG_ERR("Reactor: {}", e.what());
+      }
+    }
+  });
+}
+
+Reactor::~Reactor() {
+  work.reset();
+  context.stop();
+}
+
+Reactor& Reactor::Shared() {
+  static Reactor* reactor = new Reactor();
+  return *reactor;
+}
+
+} // namespace rpc
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "boost/asio/executor_work_guard.hpp"
+#include "boost/asio/io_context.hpp"
+#include <thread>
+
+namespace rpc {
+
+namespace asio = boost::asio;
+
+// Single I/O thread that runs the async reads and writes of every client
+// attached to it, instead of a blocking read and write thread per client.
+// Uses kqueue/epoll through asio.
+class Reactor {
+private:
+  asio::io_context context;
+  asio::executor_work_guard<asio::io_context::executor_type> work;
+  std::jthread thread;
+
+public:
+  Reactor();
+  Reactor(const Reactor&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+  ~Reactor();
+
+  asio::io_context& Context() { return context; }
+
+  // process wide reactor, created on first use and never destroyed,
+  // since clients can be released on the reactor thread after main returns
+  static Reactor& Shared();
+};
+
+} // namespace rpc
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <type_traits>
+#include "msgpack.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace rpc {
+
+// Forward only cursor over raw msgpack bytes.
+// Used to decode hot messages (redraw) without building a msgpack::object tree.
+// Read functions throw msgpack::insufficient_bytes if the data ends early and
+// msgpack::type_error on unexpected types, same as msgpack::object::convert.
+class Reader {
+private:
+  const char* data = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+
+public:
+  Reader() = default;
+  Reader(const char* _data, size_t _size) : data(_data), size(_size) {
+  }
+  Reader(std::span<const char> bytes) : data(bytes.data()), size(bytes.size()) {
+  }
+
+  size_t Offset() const {
+    return offset;
+  }
+  size_t Remaining() const {
+    return size - offset;
+  }
+  bool Empty() const {
+    return offset >= size;
+  }
+
+  bool IsNil() const {
+    return !Empty() && uint8_t(data[offset]) == 0xc0;
+  }
+
+  uint32_t ReadArray() {
+    uint8_t b = Byte();
+    if (b >= 0x90 && b <= 0x9f) return b & 0x0f;
+    if (b == 0xdc) return Load<uint16_t>();
+    if (b == 0xdd) return Load<uint32_t>();
+    throw msgpack::type_error();
+  }
+
+  uint32_t ReadMap() {
+    uint8_t b = Byte();
+    if (b >= 0x80 && b <= 0x8f) return b & 0x0f;
+    if (b == 0xde) return Load<uint16_t>();
+    if (b == 0xdf) return Load<uint32_t>();
+    throw msgpack::type_error();
+  }
+
+  int64_t ReadInt() {
+    uint8_t b = Byte();
+    if (b <= 0x7f) return b;
+    if (b >= 0xe0) return int8_t(b);
+    switch (b) {
+      case 0xcc: return Load<uint8_t>();
+      case 0xcd: return Load<uint16_t>();
+      case 0xce: return Load<uint32_t>();
+      case 0xcf: return int64_t(Load<uint64_t>());
+      case 0xd0: return int8_t(Load<uint8_t>());
+      case 0xd1: return int16_t(Load<uint16_t>());
+      case 0xd2: return int32_t(Load<uint32_t>());
+      case 0xd3: return int64_t(Load<uint64_t>());
+    }
+    throw msgpack::type_error();
+  }
+
+  double ReadFloat() {
+    uint8_t b = Byte();
+    if (b == 0xca) return std::bit_cast<float>(Load<uint32_t>());
+    if (b == 0xcb) return std::bit_cast<double>(Load<uint64_t>());
+    // nvim sends whole numbers as integers
+    offset--;
+    return double(ReadInt());
+  }
+
+  bool ReadBool() {
+    uint8_t b = Byte();
+    if (b == 0xc2) return false;
+    if (b == 0xc3) return true;
+    throw msgpack::type_error();
+  }
+
+  void ReadNil() {
+    if (Byte() != 0xc0) throw msgpack::type_error();
+  }
+
+  // str or bin, points into the underlying bytes
+  std::string_view ReadStr() {
+    uint8_t b = Byte();
+    uint32_t len;
+    if (b >= 0xa0 && b <= 0xbf) len = b & 0x1f;
+    else if (b == 0xd9 || b == 0xc4) len = Load<uint8_t>();
+    else if (b == 0xda || b == 0xc5) len = Load<uint16_t>();
+    else if (b == 0xdb || b == 0xc6) len = Load<uint32_t>();
+    else throw msgpack::type_error();
+    return {Bytes(len), len};
+  }
+
+  // how far TrySkip got into an incomplete object, so the next try with
+  // more data resumes there instead of rescanning from the start
+  struct SkipState {
+    size_t offset = 0;  // past the last whole header, from the object's start
+    size_t pending = 1; // objects left to skip
+  };
+
+  // skips the next object, returns false without moving if it's incomplete
+  bool TrySkip() noexcept {
+    SkipState state;
+    return TrySkip(state);
+  }
+
+  // same, resuming from state. the object must start at the same byte on
+  // every try, state is reset once it's complete
+  bool TrySkip(SkipState& state) noexcept {
+    size_t start = offset;
+    offset = start + state.offset;
+    while (state.pending > 0) {
+      size_t headerStart = offset;
+      size_t pending = state.pending - 1;
+      if (!SkipHeader(pending)) {
+        state.offset = headerStart - start;
+        offset = start;
+        return false;
+      }
+      state.pending = pending;
+    }
+    state = {};
+    return true;
+  }
+
+  void Skip() {
+    if (!TrySkip()) throw msgpack::insufficient_bytes("rpc::Reader: insufficient bytes");
+  }
+
+  // raw bytes of the next object
+  std::span<const char> ReadRaw() {
+    size_t start = offset;
+    Skip();
+    return {data + start, offset - start};
+  }
+
+  // unpacks the next object into zone, for the cold paths
+  msgpack::object ReadObject(msgpack::zone& zone) {
+    return msgpack::unpack(zone, data, size, offset);
+  }
+
+private:
+  void Need(size_t n) const {
+    if (size - offset < n) {
+      throw msgpack::insufficient_bytes("rpc::Reader: insufficient bytes");
+    }
+  }
+
+  uint8_t Byte() {
+    Need(1);
+    return uint8_t(data[offset++]);
+  }
+
+  const char* Bytes(size_t n) {
+    Need(n);
+    const char* ptr = data + offset;
+    offset += n;
+    return ptr;
+  }
+
+  // msgpack is big endian
+  template <typename T>
+  T Load() {
+    T value;
+    std::memcpy(&value, Bytes(sizeof(T)), sizeof(T));
+    if constexpr (sizeof(T) > 1 && std::endian::native == std::endian::little) {
+      value = std::byteswap(value);
+    }
+    return value;
+  }
+
+  // non throwing versions for TrySkip
+  bool Has(size_t n) const {
+    return size - offset >= n;
+  }
+
+  template <typename T>
+  bool TryLoad(size_t& out) {
+    if (!Has(sizeof(T))) return false;
+    out = Load<T>();
+    return true;
+  }
+
+  bool Advance(size_t n) {
+    if (!Has(n)) return false;
+    offset += n;
+    return true;
+  }
+
+  // skips the header and payload of the next object,
+  // adds the number of child objects to pending
+  bool SkipHeader(size_t& pending) {
+    if (!Has(1)) return false;
+    uint8_t b = data[offset++];
+    size_t n = 0;
+
+    if (b <= 0x7f || b >= 0xe0) return true; // fixint
+    if (b >= 0xa0 && b <= 0xbf) return Advance(b & 0x1f); // fixstr
+    if (b >= 0x80 && b <= 0x8f) { // fixmap
+      pending += (b & 0x0f) * 2;
+      return true;
+    }
+    if (b >= 0x90 && b <= 0x9f) { // fixarray
+      pending += b & 0x0f;
+      return true;
+    }
+
+    switch (b) {
+      case 0xc0: case 0xc2: case 0xc3: return true;
+      case 0xcc: case 0xd0: return Advance(1);
+      case 0xcd: case 0xd1: return Advance(2);
+      case 0xce: case 0xd2: case 0xca: return Advance(4);
+      case 0xcf: case 0xd3: case 0xcb: return Advance(8);
+      case 0xd4: return Advance(2);
+      case 0xd5: return Advance(3);
+      case 0xd6: return Advance(5);
+      case 0xd7: return Advance(9);
+      case 0xd8: return Advance(17);
+      case 0xc4: case 0xd9: return TryLoad<uint8_t>(n) && Advance(n);
+      case 0xc5: case 0xda: return TryLoad<uint16_t>(n) && Advance(n);
+      case 0xc6: case 0xdb: return TryLoad<uint32_t>(n) && Advance(n);
+      case 0xc7: return TryLoad<uint8_t>(n) && Advance(n + 1);
+      case 0xc8: return TryLoad<uint16_t>(n) && Advance(n + 1);
+      case 0xc9: return TryLoad<uint32_t>(n) && Advance(n + 1);
+      case 0xdc: case 0xdd: {
+        bool ok = b == 0xdc ? TryLoad<uint16_t>(n) : TryLoad<uint32_t>(n);
+        pending += n;
+        return ok;
+      }
+      case 0xde: case 0xdf: {
+        bool ok = b == 0xde ? TryLoad<uint16_t>(n) : TryLoad<uint32_t>(n);
+        pending += n * 2;
+        return ok;
+      }
+    }
+    // 0xc1 is never used, step over it so framing can't stall on bad data
+    return true;
+  }
+};
+
+} // namespace rpc
@@ -0,0 +1,82 @@
+#include "./recording.hpp"
+#include "boost/asio/error.hpp"
+#include "utils/logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace rpc {
+
+// Recorder -----------------------------------------------
+bool Recorder::Open(const std::string& path) {
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    LOG_ERR("Recorder::Open: failed to open {}", path);
+    return false;
+  }
+  file.write(recordingMagic, sizeof(recordingMagic));
+  start = std::chrono::steady_clock::now();
+  return true;
+}
+
+void Recorder::Write(std::span<const char> bytes) {
+  uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start
+                  ).count();
+  uint32_t size = bytes.size();
+  file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+  file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  file.write(bytes.data(), bytes.size());
+}
+
+// Replayer -----------------------------------------------
+bool Replayer::Open(const std::string& path, bool _realtime) {
+  file.open(path, std::ios::binary);
+  char magic[sizeof(recordingMagic)];
+  if (!file.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, recordingMagic, sizeof(magic)) != 0) {
+    LOG_ERR("Replayer::Open: {} is not an rpc recording", path);
+    return false;
+  }
+  realtime = _realtime;
+  start = std::chrono::steady_clock::now();
+  return true;
+}
+
+bool Replayer::NextChunk() {
+  uint64_t time;
+  uint32_t size;
+  if (!file.read(reinterpret_cast<char*>(&time), sizeof(time)) ||
+      !file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    return false;
+  }
+  chunk.resize(size);
+  chunkOffset = 0;
+  if (!file.read(chunk.data(), size)) {
+    LOG_WARN("Replayer::NextChunk: recording is truncated");
+    return false;
+  }
+
+  if (realtime) {
+    std::this_thread::sleep_until(start + std::chrono::nanoseconds(time));
+  }
+  return true;
+}
+
+size_t
+Replayer::ReadSome(boost::asio::mutable_buffer buffer, boost::system::error_code& ec) {
+  while (chunkOffset == chunk.size()) {
+    if (!NextChunk()) {
+      ec = boost::asio::error::eof;
+      return 0;
+    }
+  }
+
+  size_t length = std::min(buffer.size(), chunk.size() - chunkOffset);
+  std::memcpy(buffer.data(), chunk.data() + chunkOffset, length);
+  chunkOffset += length;
+  ec = {};
+  return length;
+}
+
+} // namespace rpc
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "boost/asio/buffer.hpp"
+#include "boost/system/error_code.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace rpc {
+
+// Recorded rpc input, as received from nvim.
+// File layout: magic, then one record per read:
+// [uint64 nanoseconds since recording started][uint32 size][size bytes],
+// integers in native byte order.
+inline constexpr char recordingMagic[8] = {'N', 'G', 'R', 'P', 'C', '0', '0', '1'};
+
+// Appends every chunk read by a client, written by the reader thread.
+class Recorder {
+private:
+  std::ofstream file;
+  std::chrono::steady_clock::time_point start;
+
+public:
+  bool Open(const std::string& path);
+  bool IsOpen() const { return file.is_open(); }
+  void Write(std::span<const char> bytes);
+};
+
+// Plays a recording back as a byte stream, used as the client's transport
+// in place of a pipe or socket. Chunk boundaries and (if realtime) timing
+// are the recorded ones.
+class Replayer {
+private:
+  std::ifstream file;
+  bool realtime = false;
+  std::chrono::steady_clock::time_point start;
+
+  std::vector<char> chunk;
+  size_t chunkOffset = 0;
+
+  bool NextChunk();
+
+public:
+  bool Open(const std::string& path, bool realtime);
+
+  // same contract as read_some, sets eof at the end of the recording
+  size_t ReadSome(boost::asio::mutable_buffer buffer, boost::system::error_code& ec);
+};
+
+} // namespace rpc
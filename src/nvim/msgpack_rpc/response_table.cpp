@@ -0,0 +1,151 @@
+#include "./response_table.hpp"
+#include <bit>
+#include <thread>
+
+namespace rpc {
+
+ResponseTable::ResponseTable(size_t capacity) {
+  tables.push_back(std::make_unique<Table>(std::bit_ceil(capacity)));
+  current = tables.back().get();
+}
+
+size_t ResponseTable::Capacity() const {
+  return current.load(std::memory_order_acquire)->mask + 1;
+}
+
+void ResponseTable::Register(
+  uint32_t msgid, std::promise<msgpack::object_handle>&& promise
+) {
+  std::scoped_lock lock(mutex);
+
+  Slot* slot = &(*current.load(std::memory_order_relaxed))[msgid];
+  uint64_t tag = slot->tag.load(std::memory_order_acquire);
+  // a take in progress, about to free the slot
+  while (TagState(tag) == Busy) {
+    std::this_thread::yield();
+    tag = slot->tag.load(std::memory_order_acquire);
+  }
+  if (TagState(tag) != Empty) {
+    Grow(msgid);
+    slot = &(*current.load(std::memory_order_relaxed))[msgid];
+  }
+
+  slot->call.promise = std::move(promise);
+  slot->tag.store(Tag(msgid, Pending), std::memory_order_release);
+}
+
+bool ResponseTable::Attach(
+  uint32_t msgid, TimerWheel::Id timer, std::unique_ptr<StopCallback>& onStop
+) {
+  std::scoped_lock lock(mutex);
+
+  Slot& slot = (*current.load(std::memory_order_relaxed))[msgid];
+  uint64_t expected = Tag(msgid, Pending);
+  if (!slot.tag.compare_exchange_strong(
+        expected, Tag(msgid, Busy), std::memory_order_acq_rel
+      )) {
+    return false;
+  }
+  slot.call.timer = timer;
+  slot.call.onStop = std::move(onStop);
+  slot.tag.store(Tag(msgid, Pending), std::memory_order_release);
+  return true;
+}
+
+std::optional<ResponseTable::Call> ResponseTable::Take(uint32_t msgid) {
+  while (true) {
+    Table* table = current.load(std::memory_order_acquire);
+    Slot& slot = (*table)[msgid];
+    uint64_t tag = slot.tag.load(std::memory_order_acquire);
+
+    if (TagMsgid(tag) != msgid || TagState(tag) == Empty) {
+      // not pending, unless a grow published a new table in between
+      if (table == current.load(std::memory_order_acquire)) return std::nullopt;
+      continue;
+    }
+    if (TagState(tag) != Pending) {
+      // busy or moved, wait for the other side to finish
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (slot.tag.compare_exchange_weak(tag, Tag(msgid, Busy), std::memory_order_acq_rel)) {
+      Call call = std::move(slot.call);
+      slot.call = {};
+      slot.tag.store(Tag(0, Empty), std::memory_order_release);
+      return call;
+    }
+  }
+}
+
+std::vector<std::pair<uint32_t, ResponseTable::Call>> ResponseTable::TakeAll() {
+  std::scoped_lock lock(mutex);
+
+  std::vector<std::pair<uint32_t, Call>> calls;
+  Table& table = *current.load(std::memory_order_relaxed);
+  for (size_t i = 0; i <= table.mask; i++) {
+    uint64_t tag = table.slots[i].tag.load(std::memory_order_acquire);
+    if (TagState(tag) != Pending) continue;
+    uint32_t msgid = TagMsgid(tag);
+    if (auto call = Take(msgid)) {
+      calls.emplace_back(msgid, std::move(*call));
+    }
+  }
+  return calls;
+}
+
+// called with the mutex held
+void ResponseTable::Grow(uint32_t msgid) {
+  Table& old = *current.load(std::memory_order_relaxed);
+
+  // find a capacity where all pending msgids map to different slots
+  std::vector<uint32_t> msgids{msgid};
+  for (size_t i = 0; i <= old.mask; i++) {
+    uint64_t tag = old.slots[i].tag.load(std::memory_order_acquire);
+    if (TagState(tag) == Pending) msgids.push_back(TagMsgid(tag));
+  }
+  size_t capacity = (old.mask + 1) * 2;
+  while (true) {
+    std::vector<bool> used(capacity);
+    bool fits = true;
+    for (uint32_t id : msgids) {
+      size_t index = id & (capacity - 1);
+      if (used[index]) {
+        fits = false;
+        break;
+      }
+      used[index] = true;
+    }
+    if (fits) break;
+    capacity *= 2;
+  }
+
+  auto table = std::make_unique<Table>(capacity);
+  for (size_t i = 0; i <= old.mask; i++) {
+    Slot& slot = old.slots[i];
+    uint64_t tag = slot.tag.load(std::memory_order_acquire);
+    while (true) {
+      if (TagState(tag) == Busy) {
+        std::this_thread::yield();
+        tag = slot.tag.load(std::memory_order_acquire);
+        continue;
+      }
+      if (TagState(tag) != Pending) break;
+
+      uint32_t id = TagMsgid(tag);
+      if (slot.tag.compare_exchange_weak(tag, Tag(id, Busy), std::memory_order_acq_rel)) {
+        Slot& dest = (*table)[id];
+        dest.call = std::move(slot.call);
+        dest.tag.store(Tag(id, Pending), std::memory_order_relaxed);
+        slot.call = {};
+        slot.tag.store(Tag(id, Moved), std::memory_order_release);
+        break;
+      }
+    }
+  }
+
+  current.store(table.get(), std::memory_order_release);
+  tables.push_back(std::move(table));
+}
+
+} // namespace rpc
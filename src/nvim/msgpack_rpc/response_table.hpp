@@ -0,0 +1,85 @@
+#pragma once
+
+#include <type_traits>
+#include "msgpack.hpp"
+#include "utils/timer_wheel.hpp"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+// Pending calls indexed by msgid % capacity.
+// msgids increase monotonically, so slots are reused in order and the table
+// only grows when a call is still pending a full capacity later.
+// Registering, attaching and growing are serialized by a mutex (calling
+// threads), taking a call (response, timeout, cancel) is lock-free.
+class ResponseTable {
+public:
+  using StopCallback = std::stop_callback<std::function<void()>>;
+
+  struct Call {
+    std::promise<msgpack::object_handle> promise;
+    TimerWheel::Id timer = 0;
+    std::unique_ptr<StopCallback> onStop;
+  };
+
+  explicit ResponseTable(size_t capacity = 256);
+  ResponseTable(const ResponseTable&) = delete;
+  ResponseTable& operator=(const ResponseTable&) = delete;
+
+  void Register(uint32_t msgid, std::promise<msgpack::object_handle>&& promise);
+  // attaches deadline/cancellation state, returns false if already taken
+  bool Attach(uint32_t msgid, TimerWheel::Id timer, std::unique_ptr<StopCallback>& onStop);
+  // removes and returns the call, nullopt if not pending
+  std::optional<Call> Take(uint32_t msgid);
+  // removes every pending call, with its msgid
+  std::vector<std::pair<uint32_t, Call>> TakeAll();
+
+  size_t Capacity() const;
+
+private:
+  enum State : uint64_t {
+    Empty,
+    Pending,
+    Busy, // being taken, attached or moved
+    Moved, // moved to a newer table
+  };
+
+  // msgid and state packed, so both are checked with a single CAS
+  static uint64_t Tag(uint32_t msgid, State state) {
+    return uint64_t(msgid) << 8 | state;
+  }
+  static uint32_t TagMsgid(uint64_t tag) { return tag >> 8; }
+  static State TagState(uint64_t tag) { return State(tag & 0xff); }
+
+  struct Slot {
+    std::atomic_uint64_t tag = 0;
+    Call call;
+  };
+
+  struct Table {
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    explicit Table(size_t capacity)
+        : mask(capacity - 1), slots(std::make_unique<Slot[]>(capacity)) {
+    }
+    Slot& operator[](uint32_t msgid) { return slots[msgid & mask]; }
+  };
+
+  std::atomic<Table*> current;
+  // older tables are kept, lock-free readers may still be looking at them
+  std::vector<std::unique_ptr<Table>> tables;
+  std::mutex mutex;
+
+  void Grow(uint32_t msgid);
+};
+
+} // namespace rpc
@@ -8,8 +8,24 @@
 
 using namespace std::chrono_literals;
 
-bool Nvim::ConnectStdio(bool interactive, const std::string& dir) {
-  client = std::make_shared<rpc::Client>();
+Nvim::~Nvim() {
+  if (client) client->TryDisconnect();
+}
+
+void Nvim::SetupRedraw() {
+  if (uiEvents == nullptr) {
+    client->SetRawNotification("redraw");
+    return;
+  }
+  client->SetRawNotification("redraw", [uiEvents = uiEvents](rpc::Notification&& notif) {
+    ParseUiRedraw(notif.rawParams, std::move(notif._zone), *uiEvents);
+  });
+}
+
+bool Nvim::ConnectStdio(bool interactive, const std::string& dir, bool sharedReactor) {
+  client = std::make_shared<rpc::Client>(sharedReactor ? &rpc::Reactor::Shared() : nullptr);
+  SetupRedraw();
+  if (!recordPath.empty()) client->StartRecording(recordPath);
 
   // std::string luaInitPath = ROOT_DIR "/lua/init.lua";
   // std::string cmd = "nvim --embed --headless "
@@ -19,8 +35,11 @@ bool Nvim::ConnectStdio(bool interactive, const std::string& dir) {
   return client->ConnectStdio(cmd, interactive, dir);
 }
 
-std::future<bool> Nvim::ConnectTcp(std::string_view host, uint16_t port) {
-  client = std::make_shared<rpc::Client>();
+std::future<bool>
+Nvim::ConnectTcp(std::string_view host, uint16_t port, bool sharedReactor) {
+  client = std::make_shared<rpc::Client>(sharedReactor ? &rpc::Reactor::Shared() : nullptr);
+  SetupRedraw();
+  if (!recordPath.empty()) client->StartRecording(recordPath);
 
   auto timeout = 500ms;
   auto elapsed = 0ms;
@@ -42,16 +61,27 @@ std::future<bool> Nvim::ConnectTcp(std::string_view host, uint16_t port) {
   co_return true;
 }
 
+bool Nvim::ConnectUnixSocket(const std::string& path, bool sharedReactor) {
+  client = std::make_shared<rpc::Client>(sharedReactor ? &rpc::Reactor::Shared() : nullptr);
+  SetupRedraw();
+  if (!recordPath.empty()) client->StartRecording(recordPath);
+
+  return client->ConnectUnixSocket(path);
+}
+
 void Nvim::GuiSetup(bool multigrid) {
   std::stringstream buffer;
   std::string luaInitPath = resourcesDir / "lua/init.lua";
   std::ifstream stream(luaInitPath);
   buffer << stream.rdbuf();
 
+  // bounds startup if nvim hangs (throws rpc::CallAborted)
+  rpc::CallOptions setupOpts{.timeout = 10s};
+
   GetAll(
-    Command("set runtimepath+=" + resourcesDir.string()),
-    ExecLua(buffer.str(), {}),
-    Command("runtime! ginit.{vim,lua}"),
+    Command("set runtimepath+=" + resourcesDir.string(), setupOpts),
+    ExecLua(buffer.str(), {}, setupOpts),
+    Command("runtime! ginit.{vim,lua}", setupOpts),
     SetClientInfo(
       "neogurt",
       {
@@ -61,7 +91,7 @@ void Nvim::GuiSetup(bool multigrid) {
         {"prerelease", VERSION_SUFFIX},
         {"commit", VERSION_COMMIT},
       },
-      "ui", {}, {}
+      "ui", {}, {}, setupOpts
     )
   ).get();
 
@@ -71,7 +101,8 @@ void Nvim::GuiSetup(bool multigrid) {
       {"rgb", true},
       {"ext_linegrid", true},
       {"ext_multigrid", multigrid},
-    }
+    },
+    setupOpts
   ).get();
 }
 
@@ -79,67 +110,90 @@ bool Nvim::IsConnected() {
   return client->IsConnected();
 }
 
-Nvim::Response Nvim::SetClientInfo(
+Nvim::Response<api::SetClientInfo> Nvim::SetClientInfo(
   std::string_view name,
   MapRef version,
   std::string_view type,
   MapRef methods,
-  MapRef attributes
+  MapRef attributes,
+  const rpc::CallOptions& callOpts
 ) {
-  return client->Call("nvim_set_client_info", name, version, type, methods, attributes);
+  return {client->Call(
+    callOpts, api::SetClientInfo{name, version, type, methods, attributes}
+  )};
 }
 
-Nvim::Response Nvim::UiAttach(int width, int height, MapRef options) {
-  return client->Call("nvim_ui_attach", width, height, options);
+Nvim::Response<api::UiAttach> Nvim::UiAttach(
+  int width, int height, MapRef options, const rpc::CallOptions& callOpts
+) {
+  return {client->Call(callOpts, api::UiAttach{width, height, options})};
 }
 
-Nvim::Response Nvim::UiDetach() {
-  return client->Call("nvim_ui_detach");
+Nvim::Response<api::UiDetach> Nvim::UiDetach(const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::UiDetach{})};
 }
 
-Nvim::Response Nvim::UiTryResize(int width, int height) {
-  return client->Call("nvim_ui_try_resize", width, height);
+Nvim::Response<api::UiTryResize>
+Nvim::UiTryResize(int width, int height, const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::UiTryResize{width, height})};
 }
 
-Nvim::Response Nvim::Input(std::string_view input) {
-  return client->Call("nvim_input", input);
+Nvim::Response<api::Input>
+Nvim::Input(std::string_view input, const rpc::CallOptions& callOpts) {
+  rpc::CallOptions inputOpts = callOpts;
+  inputOpts.priority = true;
+  return {client->Call(inputOpts, api::Input{input})};
 }
 
-Nvim::Response Nvim::InputMouse(
+Nvim::Response<api::InputMouse> Nvim::InputMouse(
   std::string_view button,
   std::string_view action,
   std::string_view modifier,
   int grid,
   int row,
-  int col
+  int col,
+  const rpc::CallOptions& callOpts
 ) {
-  return client->Call("nvim_input_mouse", button, action, modifier, grid, row, col);
+  rpc::CallOptions inputOpts = callOpts;
+  inputOpts.priority = true;
+  return {client->Call(
+    inputOpts, api::InputMouse{button, action, modifier, grid, row, col}
+  )};
 }
 
-Nvim::Response Nvim::ListUis() {
-  return client->Call("nvim_list_uis");
+Nvim::Response<api::ListUis> Nvim::ListUis(const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::ListUis{})};
 }
 
-Nvim::Response Nvim::GetOptionValue(std::string_view name, MapRef opts) {
-  return client->Call("nvim_get_option_value", name, opts);
+Nvim::Response<api::GetOptionValue> Nvim::GetOptionValue(
+  std::string_view name, MapRef opts, const rpc::CallOptions& callOpts
+) {
+  return {client->Call(callOpts, api::GetOptionValue{name, opts})};
 }
 
-Nvim::Response Nvim::SetVar(std::string_view name, VariantRef value) {
-  return client->Call("nvim_set_var", name, value);
+Nvim::Response<api::SetVar> Nvim::SetVar(
+  std::string_view name, VariantRef value, const rpc::CallOptions& callOpts
+) {
+  return {client->Call(callOpts, api::SetVar{name, value})};
 }
 
-Nvim::Response Nvim::GetVar(std::string_view name) {
-  return client->Call("nvim_get_var", name);
+Nvim::Response<api::GetVar>
+Nvim::GetVar(std::string_view name, const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::GetVar{name})};
 }
 
-Nvim::Response Nvim::ExecLua(std::string_view code, VectorRef args) {
-  return client->Call("nvim_exec_lua", code, args);
+Nvim::Response<api::ExecLua> Nvim::ExecLua(
+  std::string_view code, VectorRef args, const rpc::CallOptions& callOpts
+) {
+  return {client->Call(callOpts, api::ExecLua{code, args})};
 }
 
-Nvim::Response Nvim::Command(std::string_view command) {
-  return client->Call("nvim_command", command);
+Nvim::Response<api::Command>
+Nvim::Command(std::string_view command, const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::Command{command})};
 }
 
-Nvim::Response Nvim::GetHl(int nsId, MapRef opts) {
-  return client->Call("nvim_get_hl", nsId, opts);
+Nvim::Response<api::GetHl>
+Nvim::GetHl(int nsId, MapRef opts, const rpc::CallOptions& callOpts) {
+  return {client->Call(callOpts, api::GetHl{nsId, opts})};
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "event/ui_parse.hpp"
+#include "nvim/api.hpp"
+#include "nvim/msgpack_rpc/message.hpp"
 #include <future>
 #include <memory>
+#include <string>
 #include <string_view>
 
 // Forward declaration
@@ -14,43 +17,74 @@ struct Nvim {
   std::shared_ptr<rpc::Client> client;
   // int channelId;
 
-  bool ConnectStdio(bool interactive, const std::string& dir = {});
-  std::future<bool> ConnectTcp(std::string_view host, uint16_t port);
+  // if set before connecting, redraw notifications are parsed into it
+  // on the reader thread instead of being queued as messages
+  std::shared_ptr<UiEvents> uiEvents;
+  // if set before connecting, everything read from nvim is recorded to it
+  std::string recordPath;
+
+  Nvim() = default;
+  Nvim(const Nvim&) = delete;
+  Nvim& operator=(const Nvim&) = delete;
+  // in reactor mode the client is kept alive by its pending io until disconnected
+  ~Nvim();
+
+  // sharedReactor: run the rpc io on rpc::Reactor::Shared() instead of
+  // per client threads
+  bool ConnectStdio(
+    bool interactive, const std::string& dir = {}, bool sharedReactor = false
+  );
+  std::future<bool>
+  ConnectTcp(std::string_view host, uint16_t port, bool sharedReactor = false);
+  // attach to a running nvim started with --listen <path>
+  bool ConnectUnixSocket(const std::string& path, bool sharedReactor = false);
   void GuiSetup(bool multigrid);
+  void SetupRedraw();
   bool IsConnected();
 
-  using Variant = msgpack::type::variant;
-  using VariantRef = msgpack::type::variant_ref;
-  using MapRef = const std::map<std::string_view, VariantRef>&;
-  using VectorRef = const std::vector<VariantRef>&;
+  using VariantRef = api::ObjectRef;
+  using MapRef = api::DictRef;
+  using VectorRef = api::ArrayRef;
 
-  // .get() on Response type may throw runtime_error if reponse has error
-  using Response = std::future<msgpack::object_handle>;
+  // typed result of the api function Fn (nvim/api.hpp).
+  // .get() may throw runtime_error if reponse has error,
+  // or rpc::CallAborted if opts set a timeout/stopToken or nvim disconnected
+  template <typename Fn>
+  using Response = api::Future<typename Fn::Result>;
 
-  Response SetClientInfo(
+  Response<api::SetClientInfo> SetClientInfo(
     std::string_view name,
     MapRef version,
     std::string_view type,
     MapRef methods,
-    MapRef attributes
+    MapRef attributes,
+    const rpc::CallOptions& callOpts = {}
   );
-  Response UiAttach(int width, int height, MapRef options);
-  Response UiDetach();
-  Response UiTryResize(int width, int height);
-  Response Input(std::string_view input);
-  Response InputMouse(
+  Response<api::UiAttach>
+  UiAttach(int width, int height, MapRef options, const rpc::CallOptions& callOpts = {});
+  Response<api::UiDetach> UiDetach(const rpc::CallOptions& callOpts = {});
+  Response<api::UiTryResize>
+  UiTryResize(int width, int height, const rpc::CallOptions& callOpts = {});
+  Response<api::Input> Input(std::string_view input, const rpc::CallOptions& callOpts = {});
+  Response<api::InputMouse> InputMouse(
     std::string_view button,
     std::string_view action,
     std::string_view modifier,
     int grid,
     int row,
-    int col
+    int col,
+    const rpc::CallOptions& callOpts = {}
+  );
+  Response<api::ListUis> ListUis(const rpc::CallOptions& callOpts = {});
+  Response<api::GetOptionValue> GetOptionValue(
+    std::string_view name, MapRef opts, const rpc::CallOptions& callOpts = {}
   );
-  Response ListUis();
-  Response GetOptionValue(std::string_view name, MapRef opts);
-  Response SetVar(std::string_view name, VariantRef value);
-  Response GetVar(std::string_view name);
-  Response ExecLua(std::string_view code, VectorRef args);
-  Response Command(std::string_view command);
-  Response GetHl(int nsId, MapRef opts);
+  Response<api::SetVar>
+  SetVar(std::string_view name, VariantRef value, const rpc::CallOptions& callOpts = {});
+  Response<api::GetVar> GetVar(std::string_view name, const rpc::CallOptions& callOpts = {});
+  Response<api::ExecLua>
+  ExecLua(std::string_view code, VectorRef args, const rpc::CallOptions& callOpts = {});
+  Response<api::Command>
+  Command(std::string_view command, const rpc::CallOptions& callOpts = {});
+  Response<api::GetHl> GetHl(int nsId, MapRef opts, const rpc::CallOptions& callOpts = {});
 };
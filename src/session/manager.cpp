@@ -174,7 +174,7 @@ int SessionManager::SessionNew(const SessionNewOpts& opts) {
   int id = currId++;
   auto name = opts.name.empty() ? std::format("session {}", id) : opts.name;
 
-  auto [it, success] = sessions.try_emplace(id, std::make_shared<Session>(id, name, opts.dir));
+  auto [it, success] = sessions.try_emplace(id, std::make_shared<Session>(id, name, opts.dir, opts.address));
   if (!success) {
     throw std::runtime_error("Session with id " + std::to_string(id) + " failed to be created");
   }
@@ -187,13 +187,23 @@ int SessionManager::SessionNew(const SessionNewOpts& opts) {
   auto& ime = session->ime;
 
   // Nvim ------------------------------------------------------
-  if (!nvim.ConnectStdio(startupOpts.interactive, opts.dir)) {
+  nvim.uiEvents = session->uiEvents;
+  if (!startupOpts.recordRpc.empty()) {
+    nvim.recordPath = std::format("{}.{}", startupOpts.recordRpc, id);
+  }
+  if (!opts.address.empty()) {
+    if (!nvim.ConnectUnixSocket(opts.address, startupOpts.sharedReactor)) {
+      throw std::runtime_error("Failed to attach to nvim at " + opts.address);
+    }
+  } else if (!nvim.ConnectStdio(startupOpts.interactive, opts.dir, startupOpts.sharedReactor)) {
     throw std::runtime_error("Failed to connect to nvim");
   }
   nvim.GuiSetup(startupOpts.multigrid);
+  session->attachSetup = !opts.address.empty();
 
   // EditorState ---------------------------------------------------
   editorState.winManager.gridManager = &editorState.gridManager;
+  editorState.hlManager.gridManager = &editorState.gridManager;
 
   editorState.hlManager.SetOpacity(sessionOpts.opacity, sessionOpts.bgColor);
 
@@ -268,8 +278,9 @@ int SessionManager::SessionRestart(int id, const std::string& cmd, bool currDir)
   }
   auto& session = it->second;
 
-  // force disconnect if cmd is empty
-  if (cmd.empty()) {
+  // force disconnect if cmd is empty. attached sessions never run cmd, it would
+  // quit the server we reattach to, restarting is a detach and reattach
+  if (cmd.empty() || !session->address.empty()) {
     session->nvim.client->TryDisconnect();
 
   } else {
@@ -281,23 +292,19 @@ int SessionManager::SessionRestart(int id, const std::string& cmd, bool currDir)
         error(vim.v.errmsg, 0)
       end
       error('session_restart cmd=' .. cmd .. ' did not quit, change it to command that quits nvim', 0)
-    )", {cmd});
+    )", {cmd}, {.timeout = 500ms});
 
-    for (int i = 0; i < 50; i++) { // 500ms max
-      if (response.wait_for(10ms) == std::future_status::ready) {
-        // Will throw if quit failed - propagates to ProcessNeogurtCmd
-        response.get();
-        break;
-      }
-
-      if (!session->nvim.client->IsConnected()) {
-        break;
-      }
+    try {
+      // Will throw if quit failed - propagates to ProcessNeogurtCmd
+      if (response.valid()) response.get();
+    } catch (const rpc::CallAborted&) {
+      // nvim quit before responding (disconnected), or timed out
     }
   }
 
   auto dir = currDir ? session->editorState.currDir : session->dir;
-  int newId = SessionNew({session->name, dir});
+  // attached sessions attach again, the server outlives the disconnect
+  int newId = SessionNew({.name = session->name, .dir = dir, .address = session->address});
 
   return newId;
 }
@@ -366,6 +373,29 @@ std::vector<SessionListEntry> SessionManager::SessionList(const SessionListOpts&
   return entries;
 }
 
+StatsResult SessionManager::Stats() {
+  StatsResult result{
+    .zonePool = rpc::ZonePool::Shared().Stats(),
+    .bufferPool = rpc::BufferPool::Shared().Stats(),
+  };
+  for (auto& [id, session] : sessions) {
+    auto read = session->nvim.client->ReadBufferStats();
+    auto queue = session->nvim.client->MessageQueueStats();
+    result.sessions.push_back({
+      .id = id,
+      .name = session->name,
+      .readSize = read.readSize,
+      .readBufferSize = read.bufferSize,
+      .readBufferPeak = read.peakBufferSize,
+      .queueDepth = queue.depth,
+      .queueMaxDepth = queue.maxDepth,
+      .queueFullCount = queue.fullCount,
+      .unknownEvents = session->uiEvents->unknownEvents.load(std::memory_order_relaxed),
+    });
+  }
+  return result;
+}
+
 SessionHandle* SessionManager::GetCurrentSession() {
   int prevSessionId = CurrSession()->id;
 
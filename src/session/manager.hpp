@@ -4,6 +4,7 @@
 #include "event/neogurt_cmd.hpp"
 #include "session/options.hpp"
 #include "session/state.hpp"
+#include "nvim/msgpack_rpc/pool.hpp"
 #include "app/sdl_window.hpp"
 #include "gfx/renderer.hpp"
 #include <deque>
@@ -20,6 +21,9 @@ struct SessionNewOpts {
   std::string name;
   std::string dir;
   bool switchTo = true;
+  // unix socket of a running nvim (nvim --listen <path>) to attach to,
+  // instead of spawning one
+  std::string address;
 };
 
 struct SessionListOpts {
@@ -35,6 +39,42 @@ struct SessionListEntry {
   MSGPACK_DEFINE_MAP(id, name, dir);
 };
 
+// rpc telemetry of a session, sizes in bytes
+struct SessionStatsEntry {
+  int id;
+  std::string name;
+  size_t readSize;
+  size_t readBufferSize;
+  size_t readBufferPeak;
+  size_t queueDepth;
+  size_t queueMaxDepth;
+  size_t queueFullCount;
+  size_t unknownEvents;
+  MSGPACK_DEFINE_MAP(
+    id,
+    name,
+    MSGPACK_NVP("read_size", readSize),
+    MSGPACK_NVP("read_buffer_size", readBufferSize),
+    MSGPACK_NVP("read_buffer_peak", readBufferPeak),
+    MSGPACK_NVP("queue_depth", queueDepth),
+    MSGPACK_NVP("queue_max_depth", queueMaxDepth),
+    MSGPACK_NVP("queue_full_count", queueFullCount),
+    MSGPACK_NVP("unknown_events", unknownEvents)
+  );
+};
+
+struct StatsResult {
+  std::vector<SessionStatsEntry> sessions;
+  // shared by all sessions
+  rpc::PoolStats zonePool;
+  rpc::PoolStats bufferPool;
+  MSGPACK_DEFINE_MAP(
+    sessions,
+    MSGPACK_NVP("zone_pool", zonePool),
+    MSGPACK_NVP("buffer_pool", bufferPool)
+  );
+};
+
 using SessionHandle = std::shared_ptr<Session>;
 
 struct SessionManager {
@@ -84,6 +124,7 @@ public:
   bool SessionPrev();                               // returns success
   SessionListEntry SessionInfo(int id);             // returns {} if failed
   std::vector<SessionListEntry> SessionList(const SessionListOpts& opts = {});
+  StatsResult Stats();
   SessionHandle* GetCurrentSession(); // returns nullptr if should quit
 
   void FontSizeChange(float delta, bool all = false);
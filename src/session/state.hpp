@@ -11,13 +11,19 @@ struct Session {
   int id;
   std::string name;
   std::string dir;
+  // set if attached to a running nvim instead of spawning one
+  std::string address;
 
   // session data ----------------------
   Nvim nvim;
-  UiEvents uiEvents;
+  // shared with the rpc reader thread, which parses redraws into it
+  std::shared_ptr<UiEvents> uiEvents = std::make_shared<UiEvents>();
   SessionOptions sessionOpts;
   EditorState editorState;
   InputHandler input;
   ImeHandler ime;
   bool reattached = false;
+  // attached to a running nvim, VimEnter already fired there, so
+  // the highlights it would set up are requested on the first event pass
+  bool attachSetup = false;
 };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator for short lived, trivially destructible objects.
+// Nothing is freed individually, Reset() drops everything at once and keeps
+// the memory, so an arena reused for similar workloads stops allocating.
+class Arena {
+private:
+  struct Chunk {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+  std::vector<Chunk> chunks;
+  size_t currChunk = 0;
+  size_t offset = 0;
+  size_t chunkSize;
+
+  void* AllocateSlow(size_t size, size_t align) {
+    // next chunk if it's big enough, else a new one
+    while (++currChunk < chunks.size()) {
+      offset = 0;
+      if (size + align <= chunks[currChunk].size) return Allocate(size, align);
+    }
+    size_t newSize = std::max(chunkSize, size + align);
+    chunks.push_back({std::make_unique_for_overwrite<std::byte[]>(newSize), newSize});
+    currChunk = chunks.size() - 1;
+    offset = 0;
+    return Allocate(size, align);
+  }
+
+public:
+  explicit Arena(size_t _chunkSize = 64 << 10) : chunkSize(_chunkSize) {
+  }
+  Arena(Arena&& other) noexcept
+      : chunks(std::move(other.chunks)), currChunk(std::exchange(other.currChunk, 0)),
+        offset(std::exchange(other.offset, 0)), chunkSize(other.chunkSize) {
+    other.chunks.clear();
+  }
+  Arena& operator=(Arena&& other) noexcept {
+    chunks = std::move(other.chunks);
+    other.chunks.clear();
+    currChunk = std::exchange(other.currChunk, 0);
+    offset = std::exchange(other.offset, 0);
+    chunkSize = other.chunkSize;
+    return *this;
+  }
+
+  void* Allocate(size_t size, size_t align) {
+    if (currChunk < chunks.size()) {
+      auto& chunk = chunks[currChunk];
+      size_t start = (offset + align - 1) & ~(align - 1);
+      if (start + size <= chunk.size) {
+        offset = start + size;
+        return chunk.data.get() + start;
+      }
+    }
+    return AllocateSlow(size, align);
+  }
+
+  template <typename T, typename... Args>
+    requires std::is_trivially_destructible_v<T>
+  T* Make(Args&&... args) {
+    return new (Allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+  }
+
+  // value initialized
+  template <typename T>
+    requires std::is_trivially_destructible_v<T>
+  std::span<T> MakeArray(size_t count) {
+    if (count == 0) return {};
+    auto* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    std::uninitialized_value_construct_n(data, count);
+    return {data, count};
+  }
+
+  std::string_view Copy(std::string_view str) {
+    if (str.empty()) return {};
+    auto* data = static_cast<char*>(Allocate(str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    return {data, str.size()};
+  }
+
+  // everything allocated before is invalid after.
+  // If more than one chunk was used, they're merged into one of their
+  // total size, so the same workload fits in a single chunk next time.
+  void Reset() {
+    if (chunks.size() > 1) {
+      size_t total = 0;
+      for (auto& chunk : chunks) total += chunk.size;
+      chunks.clear();
+      chunks.push_back({std::make_unique_for_overwrite<std::byte[]>(total), total});
+    }
+    currChunk = 0;
+    offset = 0;
+  }
+
+  // bytes held, used or not
+  size_t Capacity() const {
+    size_t total = 0;
+    for (auto& chunk : chunks) total += chunk.size;
+    return total;
+  }
+};
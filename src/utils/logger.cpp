@@ -13,7 +13,6 @@ void Logger::RedirToPath(const fs::path& path) {
 
 void Logger::Log(const std::string& message) {
   std::unique_lock lock(mutex);
-  if (!enabled) return;
   std::cout << message << '\n';
 }
 
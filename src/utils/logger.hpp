@@ -25,15 +25,50 @@ struct Logger {
 
 inline Logger logger;
 
+// compile-time log level (cmake -DNEOGURT_LOG_LEVEL=<level>), statements
+// below it are removed along with their arguments
+#define LOG_LEVEL_DEBUG 0 // LOG, LOG_TRACE
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERR 3
+#define LOG_LEVEL_OFF 4
+#ifndef NEOGURT_LOG_LEVEL
+#define NEOGURT_LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
 // helpers
 #include <format>
+#define LOG_NOOP() ((void)0)
 #define LOG_ENABLE() logger.enabled = true
 #define LOG_DISABLE() logger.enabled = false
-#define LOG(...) logger.Log(std::format(__VA_ARGS__))
+
+#if NEOGURT_LOG_LEVEL <= LOG_LEVEL_DEBUG
+// flag is checked before formatting
+#define LOG(...) \
+  do { if (logger.enabled.load(std::memory_order_relaxed)) logger.Log(std::format(__VA_ARGS__)); } while (0)
+#define LOG_TRACE() logger.LogTrace()
+#else
+#define LOG(...) LOG_NOOP()
+#define LOG_TRACE() LOG_NOOP()
+#endif
+
+#if NEOGURT_LOG_LEVEL <= LOG_LEVEL_INFO
 #define LOG_INFO(...) logger.LogInfo(std::format(__VA_ARGS__))
+#else
+#define LOG_INFO(...) LOG_NOOP()
+#endif
+
+#if NEOGURT_LOG_LEVEL <= LOG_LEVEL_WARN
 #define LOG_WARN(...) logger.LogWarn(std::format(__VA_ARGS__))
+#else
+#define LOG_WARN(...) LOG_NOOP()
+#endif
+
+#if NEOGURT_LOG_LEVEL <= LOG_LEVEL_ERR
 #define LOG_ERR(...) logger.LogErr(std::format(__VA_ARGS__))
-#define LOG_TRACE() logger.LogTrace()
+#else
+#define LOG_ERR(...) LOG_NOOP()
+#endif
 
 #include <sstream>
 inline std::string ToString(auto&& obj) {
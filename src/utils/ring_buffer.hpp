@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -15,6 +16,11 @@ private:
     return index >= size ? index - size : index;
   }
 
+  void Reverse(size_t first, size_t last) {
+    using std::swap;
+    while (first + 1 < last) swap((*this)[first++], (*this)[--last]);
+  }
+
 public:
   // Iterator class
   class Iterator {
@@ -91,6 +97,28 @@ public:
       head = wrapIndex(head + size + lines);
   }
 
+  // scroll only [start, end), elements are swapped, never copied, so with
+  // T = std::vector this just moves pointers
+  void Scroll(size_t start, size_t end, int lines) {
+    assert(start <= end && end <= size);
+    size_t count = end - start;
+    if (count == 0) return;
+    size_t shift = lines >= 0 ? lines % count : count - (size_t(-lines) % count);
+    if (shift == 0 || shift == count) return;
+    // rotate left by shift with three reversals
+    Reverse(start, start + shift);
+    Reverse(start + shift, end);
+    Reverse(start, end);
+  }
+
+  // keeps the first min(size, newSize) elements in order, new ones are value
+  void Resize(size_t newSize, const T& value) {
+    std::rotate(buffer.begin(), buffer.begin() + head, buffer.end());
+    head = 0;
+    buffer.resize(newSize, value);
+    size = newSize;
+  }
+
   size_t Size() const {
     return size;
   }
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// bounded lock-free queue for one producer thread and one consumer thread
+template <typename T>
+class SpscQueue {
+private:
+  struct Slot {
+    alignas(T) std::byte data[sizeof(T)];
+    T* Get() { return std::launder(reinterpret_cast<T*>(data)); }
+  };
+
+  static constexpr size_t cacheLine = 64;
+
+  size_t capacity;
+  size_t mask;
+  std::unique_ptr<Slot[]> slots;
+
+  // consumer side
+  alignas(cacheLine) std::atomic_size_t head = 0;
+  size_t cachedTail = 0;
+
+  // producer side
+  alignas(cacheLine) std::atomic_size_t tail = 0;
+  size_t cachedHead = 0;
+
+  // written by the producer
+  alignas(cacheLine) std::atomic_size_t maxDepth = 0;
+
+public:
+  // capacity is rounded up to a power of two
+  explicit SpscQueue(size_t _capacity = 1024)
+      : capacity(std::bit_ceil(_capacity)), mask(capacity - 1),
+        slots(std::make_unique<Slot[]>(capacity)) {
+  }
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  ~SpscQueue() {
+    while (Front() != nullptr) Pop();
+  }
+
+  // producer ----------------------------------------
+  // returns false (and leaves value untouched) if the queue is full
+  bool TryPush(T&& value) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - cachedHead == capacity) {
+      cachedHead = head.load(std::memory_order_acquire);
+      if (t - cachedHead == capacity) return false;
+    }
+    new (slots[t & mask].data) T(std::move(value));
+    tail.store(t + 1, std::memory_order_release);
+
+    size_t depth = t + 1 - head.load(std::memory_order_relaxed);
+    if (depth > maxDepth.load(std::memory_order_relaxed)) {
+      maxDepth.store(depth, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // consumer ----------------------------------------
+  // returns nullptr if empty
+  T* Front() {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == cachedTail) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h == cachedTail) return nullptr;
+    }
+    return slots[h & mask].Get();
+  }
+
+  // must only be called after Front() returned non null
+  void Pop() {
+    size_t h = head.load(std::memory_order_relaxed);
+    assert(h != cachedTail);
+    std::destroy_at(slots[h & mask].Get());
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  // calls func on every element available at the time of the call, in order,
+  // then frees all their slots at once, returns the number of elements
+  template <typename Func>
+  size_t Drain(Func&& func) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_acquire);
+    cachedTail = t;
+
+    for (size_t i = h; i != t; i++) {
+      T* value = slots[i & mask].Get();
+      try {
+        func(*value);
+      } catch (...) {
+        std::destroy_at(value);
+        head.store(i + 1, std::memory_order_release);
+        throw;
+      }
+      std::destroy_at(value);
+    }
+    head.store(t, std::memory_order_release);
+    return t - h;
+  }
+
+  // either side ---------------------------------------
+  size_t Size() const {
+    // head first, so it can't pass the tail we read
+    size_t h = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - h;
+  }
+  bool Empty() const {
+    return Size() == 0;
+  }
+  size_t Capacity() const {
+    return capacity;
+  }
+
+  // highest depth seen by the producer
+  size_t MaxDepth() const {
+    return maxDepth.load(std::memory_order_relaxed);
+  }
+};
@@ -0,0 +1,96 @@
+#include "./timer_wheel.hpp"
+#include <algorithm>
+
+TimerWheel::TimerWheel(Clock::duration _tick, size_t numSlots)
+    : tick(_tick), slots(numSlots) {
+  thread = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+}
+
+TimerWheel::~TimerWheel() {
+  thread.request_stop();
+  cv.notify_all();
+}
+
+TimerWheel::Id TimerWheel::Schedule(Clock::duration delay, std::function<void()> func) {
+  std::scoped_lock lock(mutex);
+  auto now = Clock::now();
+  if (pending.empty()) {
+    nextTick = now + tick;
+  }
+
+  // slot currSlot + n fires at nextTick + (n - 1) * tick, which may be almost
+  // due when the wheel is running. round up from there, so timers never fire early
+  auto afterNextTick = std::max(now + delay - nextTick, Clock::duration(0));
+  size_t ticks = (afterNextTick + tick - Clock::duration(1)) / tick + 1;
+
+  Id id = nextId++;
+  size_t slot = (currSlot + ticks) % slots.size();
+  slots[slot].push_back({id, (ticks - 1) / slots.size(), std::move(func)});
+  pending[id] = slot;
+
+  cv.notify_one();
+  return id;
+}
+
+bool TimerWheel::Cancel(Id id) {
+  std::function<void()> func; // destroyed outside the lock
+  {
+    std::scoped_lock lock(mutex);
+    auto it = pending.find(id);
+    if (it == pending.end()) return false;
+
+    auto& slot = slots[it->second];
+    auto timerIt = std::ranges::find(slot, id, &Timer::id);
+    func = std::move(timerIt->func);
+    *timerIt = std::move(slot.back());
+    slot.pop_back();
+    pending.erase(it);
+  }
+  return true;
+}
+
+void TimerWheel::Run(std::stop_token stopToken) {
+  std::vector<std::function<void()>> due;
+
+  std::unique_lock lock(mutex);
+  while (!stopToken.stop_requested()) {
+    if (pending.empty()) {
+      cv.wait(lock, stopToken, [&] { return !pending.empty(); });
+      continue;
+    }
+
+    // predicate only stops the wait early when the wheel empties
+    if (cv.wait_until(lock, stopToken, nextTick, [&] { return pending.empty(); })) {
+      continue;
+    }
+
+    auto now = Clock::now();
+    while (nextTick <= now && !pending.empty()) {
+      currSlot = (currSlot + 1) % slots.size();
+      nextTick += tick;
+
+      auto& slot = slots[currSlot];
+      for (size_t i = 0; i < slot.size();) {
+        if (slot[i].rounds > 0) {
+          slot[i].rounds--;
+          i++;
+          continue;
+        }
+        due.push_back(std::move(slot[i].func));
+        pending.erase(slot[i].id);
+        slot[i] = std::move(slot.back());
+        slot.pop_back();
+      }
+    }
+
+    lock.unlock();
+    for (auto& func : due) func();
+    due.clear();
+    lock.lock();
+  }
+}
+
+TimerWheel& TimerWheel::Shared() {
+  static TimerWheel* wheel = new TimerWheel();
+  return *wheel;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Hashed timer wheel for coarse timeouts (rpc call deadlines).
+// Scheduling and cancelling are O(1), one thread sleeps until the next tick
+// and only while timers are pending.
+// Callbacks run on the wheel's thread without the lock held, keep them short.
+class TimerWheel {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Id = uint64_t;
+
+  explicit TimerWheel(
+    Clock::duration tick = std::chrono::milliseconds(10), size_t numSlots = 512
+  );
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  ~TimerWheel();
+
+  // fires after at least delay, rounded up to the tick
+  Id Schedule(Clock::duration delay, std::function<void()> func);
+  // returns false if the timer already fired or was cancelled
+  bool Cancel(Id id);
+
+  // process wide wheel, never destroyed (same as rpc::Reactor::Shared)
+  static TimerWheel& Shared();
+
+private:
+  struct Timer {
+    Id id;
+    size_t rounds; // full turns of the wheel left
+    std::function<void()> func;
+  };
+
+  Clock::duration tick;
+  std::vector<std::vector<Timer>> slots;
+  std::unordered_map<Id, size_t> pending; // id -> slot
+  size_t currSlot = 0;
+  Clock::time_point nextTick;
+  Id nextId = 1;
+
+  std::mutex mutex;
+  std::condition_variable_any cv;
+  std::jthread thread;
+
+  void Run(std::stop_token stopToken);
+};
@@ -0,0 +1,120 @@
+#include "./trace.hpp"
+#include "utils/logger.hpp"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <mutex>
+
+namespace trace {
+
+// buffers outlive their threads, so events of finished threads still dump
+static std::mutex registryMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+ThreadBuffer& LocalBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::unique_lock lock(registryMutex);
+    buffer->tid = registry.size() + 1;
+    registry.push_back(buffer);
+    return buffer;
+  }();
+  return *buffer;
+}
+
+void SetThreadName(const char* name) {
+  LocalBuffer().name.store(name, std::memory_order_relaxed);
+}
+
+std::vector<Event> Snapshot() {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::unique_lock lock(registryMutex);
+    buffers = registry;
+  }
+
+  constexpr uint64_t capacity = ThreadBuffer::capacity;
+  std::vector<Event> events;
+  for (auto& buffer : buffers) {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+    size_t offset = events.size();
+    for (uint64_t i = first; i < head; i++) {
+      events.push_back(buffer->events[i & (capacity - 1)]);
+    }
+
+    // the writer kept going while copying, drop what it overwrote and the
+    // slot it may be writing now. head doesn't move until that write is
+    // done, so the oldest slot is dropped even if head looks unchanged
+    uint64_t newHead = buffer->head.load(std::memory_order_acquire);
+    uint64_t valid = newHead + 1 > capacity ? newHead + 1 - capacity : 0;
+    if (valid > first) {
+      auto begin = events.begin() + offset;
+      events.erase(begin, begin + std::min(valid, head) - first);
+    }
+  }
+  return events;
+}
+
+bool WriteChromeTrace(const std::filesystem::path& path) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG_ERR("trace::WriteChromeTrace: failed to open {}", path.string());
+    return false;
+  }
+
+  auto events = Snapshot();
+  // chrome trace timestamps are in microseconds
+  auto Us = [](uint64_t ns) { return std::format("{}.{:03}", ns / 1000, ns % 1000); };
+  uint64_t epoch = events.empty() ? 0 : std::ranges::min(events, {}, &Event::start).start;
+
+  file << "{\"traceEvents\":[\n";
+  bool first = true;
+  auto Separate = [&] {
+    if (!first) file << ",\n";
+    first = false;
+  };
+
+  {
+    std::unique_lock lock(registryMutex);
+    for (auto& buffer : registry) {
+      const char* name = buffer->name.load(std::memory_order_relaxed);
+      if (name == nullptr) continue;
+      Separate();
+      file << std::format(
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+        buffer->tid, name
+      );
+    }
+  }
+
+  for (const auto& e : events) {
+    Separate();
+    auto ts = Us(e.start - epoch);
+    switch (e.phase) {
+      case Phase::Complete:
+        file << std::format(
+          R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{},"dur":{}}})",
+          e.name, e.tid, ts, Us(e.duration)
+        );
+        break;
+      case Phase::Instant:
+        file << std::format(
+          R"({{"name":"{}","ph":"i","s":"t","pid":1,"tid":{},"ts":{},"args":{{"value":{}}}}})",
+          e.name, e.tid, ts, e.value
+        );
+        break;
+      case Phase::Counter:
+        file << std::format(
+          R"({{"name":"{}","ph":"C","pid":1,"tid":{},"ts":{},"args":{{"value":{}}}}})",
+          e.name, e.tid, ts, e.value
+        );
+        break;
+    }
+  }
+  file << "\n]}\n";
+
+  return file.good();
+}
+
+} // namespace trace
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Structured tracing for hot paths. Every thread records fixed size binary
+// events into its own ring buffer (one writer, no locks, oldest events are
+// overwritten). The buffers are read on demand with Snapshot, or written as
+// Chrome trace json (chrome://tracing, ui.perfetto.dev) with WriteChromeTrace.
+//
+// The TRACE_* macros compile to nothing unless NEOGURT_TRACE is defined
+// (cmake -DNEOGURT_TRACE=ON), their arguments aren't evaluated then.
+// When compiled in, recording is off until SetEnabled(true) and each macro
+// costs a relaxed load; when on, a clock read and a ring buffer store.
+namespace trace {
+
+enum class Phase : uint8_t {
+  Complete, // a scope, start + duration
+  Instant,
+  Counter,
+};
+
+struct Event {
+  // must be a string literal (or otherwise outlive the trace)
+  const char* name;
+  uint64_t start;    // ns, steady clock
+  uint64_t duration; // ns, Complete only
+  int64_t value;     // Instant and Counter
+  uint32_t tid;
+  Phase phase;
+};
+
+struct ThreadBuffer {
+  static constexpr size_t capacity = 8192; // power of two
+  uint32_t tid;
+  std::atomic<const char*> name = nullptr;
+  std::unique_ptr<Event[]> events = std::make_unique<Event[]>(capacity);
+  // number of events ever written, only stored by the owning thread
+  std::atomic_uint64_t head = 0;
+};
+
+inline std::atomic_bool enabled = false;
+
+inline void SetEnabled(bool value) {
+  enabled.store(value, std::memory_order_relaxed);
+}
+inline bool IsEnabled() {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+inline uint64_t Now() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// calling thread's buffer, registered on first use
+ThreadBuffer& LocalBuffer();
+
+inline void Record(const char* name, Phase phase, uint64_t start, uint64_t duration, int64_t value) {
+  auto& buffer = LocalBuffer();
+  uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  buffer.events[head & (ThreadBuffer::capacity - 1)] =
+    {name, start, duration, value, buffer.tid, phase};
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+class Scope {
+  const char* name;
+  uint64_t start;
+
+public:
+  explicit Scope(const char* _name)
+      : name(IsEnabled() ? _name : nullptr), start(name ? Now() : 0) {
+  }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+  ~Scope() {
+    if (name) Record(name, Phase::Complete, start, Now() - start, 0);
+  }
+};
+
+inline void Instant(const char* name, int64_t value = 0) {
+  if (IsEnabled()) Record(name, Phase::Instant, Now(), 0, value);
+}
+
+inline void Counter(const char* name, int64_t value) {
+  if (IsEnabled()) Record(name, Phase::Counter, Now(), 0, value);
+}
+
+// shown as the thread's name in the trace
+void SetThreadName(const char* name);
+
+// events of all threads still in their buffers, oldest first per thread.
+// safe while other threads record, events overwritten during the copy are left out
+std::vector<Event> Snapshot();
+
+// returns false if the file couldn't be written
+bool WriteChromeTrace(const std::filesystem::path& path);
+
+} // namespace trace
+
+#ifdef NEOGURT_TRACE
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_INSTANT(name, value) trace::Instant(name, value)
+#define TRACE_COUNTER(name, value) trace::Counter(name, value)
+#define TRACE_THREAD_NAME(name) trace::SetThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_INSTANT(name, value) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,309 @@
+#include "nvim/msgpack_rpc/message_internal.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/local/stream_protocol.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Stands in for nvim when load testing rpc::Client (test/rpc_load_test.cpp).
+// Speaks msgpack-rpc over stdio, tcp or a unix socket (one connection),
+// sends scripted redraw batches at a fixed rate and answers every request
+// with its params after a fixed delay.
+//
+// usage: fake_nvim [--stdio | --tcp <port> | --unix <path>]
+//   --width 80 --height 24   grid size
+//   --lines 1                grid_line events per batch
+//   --cells 80               cells per grid_line
+//   --rate 60                batches (each ending in a flush) per second,
+//                            0 = as fast as the client reads
+//   --seconds 0              exit after, 0 = until the client disconnects
+//   --latency_us 0           delay before answering a request
+//   --request_every 0        send a neogurt_cmd request every n batches
+//
+// Latency of the requests it sent is printed to stderr on exit.
+
+using namespace std::chrono;
+namespace asio = boost::asio;
+using Clock = steady_clock;
+
+struct Options {
+  enum { Stdio, Tcp, Unix } transport = Stdio;
+  uint16_t port = 0;
+  std::string unixPath;
+
+  int width = 80;
+  int height = 24;
+  int lines = 1;
+  int cells = 80;
+  int rate = 60;
+  int seconds = 0;
+  int latencyUs = 0;
+  int requestEvery = 0;
+};
+
+static bool ParseOptions(int argc, char* argv[], Options& opts) {
+  for (int i = 1; i < argc; i++) {
+    std::string_view arg = argv[i];
+    if (arg == "--stdio") {
+      opts.transport = Options::Stdio;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    std::string value = argv[++i];
+
+    if (arg == "--tcp") {
+      opts.transport = Options::Tcp;
+      opts.port = std::stoi(value);
+    } else if (arg == "--unix") {
+      opts.transport = Options::Unix;
+      opts.unixPath = value;
+    } else if (arg == "--width") opts.width = std::stoi(value);
+    else if (arg == "--height") opts.height = std::stoi(value);
+    else if (arg == "--lines") opts.lines = std::stoi(value);
+    else if (arg == "--cells") opts.cells = std::stoi(value);
+    else if (arg == "--rate") opts.rate = std::stoi(value);
+    else if (arg == "--seconds") opts.seconds = std::stoi(value);
+    else if (arg == "--latency_us") opts.latencyUs = std::stoi(value);
+    else if (arg == "--request_every") opts.requestEvery = std::stoi(value);
+    else return false;
+  }
+  return true;
+}
+
+// writes everything or returns false
+static bool WriteAll(int fd, const msgpack::sbuffer& buffer) {
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    ssize_t n = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+    if (n <= 0) return false;
+    offset += n;
+  }
+  return true;
+}
+
+// first redraw of a session, like nvim after nvim_ui_attach
+static void PackAttach(msgpack::sbuffer& buffer, const Options& opts) {
+  msgpack::packer packer(buffer);
+  packer.pack_array(3);
+  packer.pack(int(rpc::MessageType::Notification));
+  packer.pack("redraw");
+  packer.pack_array(4);
+
+  packer.pack(
+    std::tuple("default_colors_set", std::tuple(0xffffff, 0x000000, 0xff0000, 0, 0))
+  );
+
+  std::map<std::string, int> attr{{"foreground", 0x88c0d0}};
+  packer.pack_array(9);
+  packer.pack("hl_attr_define");
+  for (int id = 1; id <= 8; id++) {
+    packer.pack(std::tuple(id, attr, attr, std::vector<int>{}));
+  }
+
+  packer.pack(std::tuple("grid_resize", std::tuple(1, opts.width, opts.height)));
+  packer.pack(std::tuple("flush", std::tuple()));
+}
+
+// one batch: grid_line events for consecutive rows, cursor move and flush
+static void PackBatch(msgpack::sbuffer& buffer, const Options& opts, int batch) {
+  msgpack::packer packer(buffer);
+  packer.pack_array(3);
+  packer.pack(int(rpc::MessageType::Notification));
+  packer.pack("redraw");
+  packer.pack_array(3);
+
+  packer.pack_array(1 + opts.lines);
+  packer.pack("grid_line");
+  int cells = std::min(opts.cells, opts.width);
+  for (int i = 0; i < opts.lines; i++) {
+    int row = (batch * opts.lines + i) % opts.height;
+    packer.pack_array(5);
+    packer.pack(1);
+    packer.pack(row);
+    packer.pack(0);
+    // mix of plain cells, highlight changes and repeats, like source code
+    packer.pack_array(cells);
+    for (int col = 0; col < cells; col++) {
+      char text[2] = {char('a' + (row + col + batch) % 26), 0};
+      if (col % 16 == 0) {
+        packer.pack(std::tuple(std::string_view(text), 1 + col / 16 % 8));
+      } else if (col % 16 == 15) {
+        packer.pack(std::tuple(" ", 0, 1));
+      } else {
+        packer.pack(std::tuple(std::string_view(text)));
+      }
+    }
+    packer.pack(false);
+  }
+
+  packer.pack(std::tuple("grid_cursor_goto", std::tuple(1, batch % opts.height, 0)));
+  packer.pack(std::tuple("flush", std::tuple()));
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  if (!ParseOptions(argc, argv, opts)) {
+    std::println(stderr, "fake_nvim: invalid arguments");
+    return 1;
+  }
+
+  // accept a single connection, then use its fd like stdio
+  asio::io_context context;
+  int readFd = STDIN_FILENO;
+  int writeFd = STDOUT_FILENO;
+  if (opts.transport == Options::Tcp) {
+    asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), opts.port);
+    asio::ip::tcp::acceptor acceptor(context, endpoint);
+    asio::ip::tcp::socket socket(context);
+    acceptor.accept(socket);
+    socket.set_option(asio::ip::tcp::no_delay(true));
+    readFd = writeFd = socket.release();
+  } else if (opts.transport == Options::Unix) {
+    std::filesystem::remove(opts.unixPath);
+    asio::local::stream_protocol::acceptor acceptor(context, {opts.unixPath});
+    asio::local::stream_protocol::socket socket(context);
+    acceptor.accept(socket);
+    readFd = writeFd = socket.release();
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  // responses waiting for their delay, in due order since the delay is fixed
+  std::deque<std::pair<Clock::time_point, msgpack::sbuffer>> responses;
+  // requests sent to the client
+  std::unordered_map<uint32_t, Clock::time_point> requestsSent;
+  std::vector<double> requestLatencies;
+
+  std::jthread reader([&] {
+    msgpack::unpacker unpacker;
+    while (true) {
+      unpacker.reserve_buffer(1 << 16);
+      ssize_t length = ::read(readFd, unpacker.buffer(), 1 << 16);
+      if (length <= 0) break;
+      unpacker.buffer_consumed(length);
+
+      msgpack::object_handle handle;
+      while (unpacker.next(handle)) {
+        auto now = Clock::now();
+        const auto& obj = handle.get();
+        int type = obj.via.array.ptr[0].convert();
+
+        std::scoped_lock lock(mutex);
+        if (type == rpc::MessageType::Request) {
+          rpc::RequestIn request(obj.convert());
+          msgpack::sbuffer buffer;
+          msgpack::pack(
+            buffer, rpc::ResponseOut{.msgid = request.msgid, .result = request.params}
+          );
+          auto due = now + microseconds(opts.latencyUs);
+          responses.emplace_back(due, std::move(buffer));
+          cv.notify_one();
+
+        } else if (type == rpc::MessageType::Response) {
+          rpc::ResponseIn response(obj.convert());
+          if (auto it = requestsSent.find(response.msgid); it != requestsSent.end()) {
+            auto latency = duration<double, std::micro>(now - it->second);
+            requestLatencies.push_back(latency.count());
+            requestsSent.erase(it);
+          }
+        }
+      }
+    }
+    std::scoped_lock lock(mutex);
+    done = true;
+    cv.notify_one();
+  });
+
+  auto start = Clock::now();
+  auto end = opts.seconds > 0 ? start + seconds(opts.seconds) : Clock::time_point::max();
+  auto interval = opts.rate > 0 ? duration_cast<Clock::duration>(seconds(1)) / opts.rate
+                                : Clock::duration::zero();
+
+  {
+    msgpack::sbuffer buffer;
+    PackAttach(buffer, opts);
+    if (!WriteAll(writeFd, buffer)) return 0;
+  }
+
+  msgpack::sbuffer buffer;
+  uint32_t msgid = 0;
+  for (int batch = 0;; batch++) {
+    auto nextBatch = start + interval * batch;
+
+    // answer requests that are due until the next batch
+    std::unique_lock lock(mutex);
+    while (true) {
+      if (done || Clock::now() >= end) break;
+      auto wakeup = nextBatch;
+      if (!responses.empty()) wakeup = std::min(wakeup, responses.front().first);
+      cv.wait_until(lock, wakeup, [&] {
+        return done || (!responses.empty() && responses.front().first <= Clock::now());
+      });
+
+      buffer.clear();
+      auto now = Clock::now();
+      while (!responses.empty() && responses.front().first <= now) {
+        auto& response = responses.front().second;
+        buffer.write(response.data(), response.size());
+        responses.pop_front();
+      }
+      if (buffer.size() > 0) {
+        lock.unlock();
+        WriteAll(writeFd, buffer);
+        lock.lock();
+      }
+      if (now >= nextBatch) break;
+    }
+    if (done || Clock::now() >= end) break;
+
+    buffer.clear();
+    PackBatch(buffer, opts, batch);
+    if (opts.requestEvery > 0 && batch % opts.requestEvery == 0) {
+      msgpack::pack(buffer, rpc::RequestOut{
+        .msgid = msgid,
+        .method = "neogurt_cmd",
+        .params = std::tuple("fake_nvim", batch),
+      });
+      requestsSent[msgid++] = Clock::now();
+    }
+    lock.unlock();
+
+    if (!WriteAll(writeFd, buffer)) break;
+  }
+
+  // the client sees eof and disconnects, which ends the reader
+  if (readFd == writeFd) {
+    ::shutdown(writeFd, SHUT_RDWR);
+  } else {
+    ::close(writeFd);
+  }
+  reader.join();
+
+  if (!requestLatencies.empty()) {
+    std::ranges::sort(requestLatencies);
+    auto Percentile = [&](double p) {
+      return requestLatencies[std::min(
+        requestLatencies.size() - 1, size_t(p * requestLatencies.size())
+      )];
+    };
+    std::println(
+      stderr, "fake_nvim: {} requests answered, p50 {:.1f}us, p99 {:.1f}us",
+      requestLatencies.size(), Percentile(0.5), Percentile(0.99)
+    );
+  }
+  return 0;
+}
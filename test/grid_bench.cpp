@@ -0,0 +1,247 @@
+#include "editor/grid.hpp"
+#include "utils/arena.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <string>
+#include <vector>
+
+// Full screen redraw benchmark: every row of a width x height grid is
+// rewritten by one grid_line (text, hl changes, a repeated run and wide
+// chars), then the grid is scrolled and cleared, like scrolling a page.
+// before: cells of {std::string text, int hlId, bool doubleWidth}
+// after:  packed 8 byte cells with interned graphemes (Grid::Cell)
+//
+// Then microbenchmarks of grid_scroll on a region leaving out the first
+// and last row (winbar, statusline), and of grid_resize toggling the height
+// (cmdline growing and shrinking):
+// scroll: cells copied line by line vs lines swapped in the ring buffer
+// resize: lines reallocated and copied vs RingBuffer::Resize
+//
+// usage: grid_bench [width] [height] [rounds]
+
+using namespace std::chrono;
+using namespace event;
+
+// GridManager as it was before packed cells
+struct StringGrid {
+  struct Cell {
+    std::string text;
+    int hlId;
+    bool doubleWidth;
+  };
+  RingBuffer<std::vector<Cell>> lines;
+
+  StringGrid(int width, int height)
+      : lines(height, std::vector<Cell>(width, Cell{" "})) {
+  }
+
+  void Line(const GridLine& e) {
+    auto& line = lines[e.row];
+    size_t col = e.colStart;
+    int recentHlId = 0;
+    for (size_t i = 0; i < e.cells.size(); i++) {
+      const auto& eventCell = e.cells[i];
+      if (eventCell.hlId) recentHlId = *eventCell.hlId;
+      if (eventCell.repeat) {
+        for (int j = 0; j < eventCell.repeat; j++) {
+          auto& cell = line[col++];
+          cell.text = eventCell.text;
+          cell.hlId = recentHlId;
+          cell.doubleWidth = false;
+        }
+      } else {
+        auto& cell = line[col++];
+        cell.text = eventCell.text;
+        cell.hlId = recentHlId;
+        cell.doubleWidth = i + 1 < e.cells.size() && e.cells[i + 1].text.empty();
+      }
+    }
+  }
+
+  void Clear() {
+    for (size_t i = 0; i < lines.Size(); i++) {
+      for (auto& cell : lines[i]) cell = Cell{" "};
+    }
+  }
+
+  // partial scroll, lines are copied
+  void Scroll(const GridScroll& e) {
+    auto copyLine = [&](int dest, int src) {
+      auto& line = lines[src];
+      std::copy(line.begin() + e.left, line.begin() + e.right, lines[dest].begin() + e.left);
+    };
+    if (e.rows > 0) {
+      for (int i = e.top; i < e.bot - e.rows; i++) copyLine(i, i + e.rows);
+    } else {
+      for (int i = e.bot - 1; i >= e.top - e.rows; i--) copyLine(i, i + e.rows);
+    }
+  }
+};
+
+// one grid_line per row, roughly what a page of code looks like
+static std::vector<GridLine> MakeRedraw(Arena& arena, int width, int height) {
+  static const char* words[] = {"int", "return", "{", "}", "GridManager", "字", "é", "->"};
+  std::vector<GridLine> lines;
+  for (int row = 0; row < height; row++) {
+    std::vector<GridLine::Cell> cells;
+    int col = 0;
+    for (int w = row; col < width * 3 / 4; w++) {
+      std::string_view word = words[w % std::size(words)];
+      // non ascii words are one grapheme
+      bool ascii = uint8_t(word[0]) < 128;
+      bool wide = word == "字";
+      int wordWidth = ascii ? word.size() : wide ? 2 : 1;
+      if (col + wordWidth > width) break;
+      cells.push_back({.text = ascii ? word.substr(0, 1) : word, .hlId = w % 40});
+      for (size_t c = 1; ascii && c < word.size(); c++) {
+        cells.push_back({.text = word.substr(c, 1)});
+      }
+      if (wide) cells.push_back({.text = ""});
+      col += wordWidth;
+      if (col == width) break;
+      cells.push_back({.text = " ", .hlId = 0});
+      col++;
+    }
+    if (col < width) cells.push_back({.text = " ", .hlId = 0, .repeat = width - col});
+
+    auto span = arena.MakeArray<GridLine::Cell>(cells.size());
+    std::ranges::copy(cells, span.begin());
+    lines.push_back({.grid = 1, .row = row, .colStart = 0, .cells = span, .wrap = false});
+  }
+  return lines;
+}
+
+template <typename Func>
+static double TimeMs(int rounds, Func&& func) {
+  auto start = steady_clock::now();
+  for (int r = 0; r < rounds; r++) func(r);
+  return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+// GridManager::Resize as it was before RingBuffer::Resize
+static void ReallocResize(Grid& grid, int width, int height) {
+  int minWidth = std::min(grid.width, width);
+  int minHeight = std::min(grid.height, height);
+
+  auto oldLines(std::move(grid.lines));
+  grid.lines = Grid::Lines(height, Grid::Line(width, Grid::Cell{}));
+
+  for (int i = 0; i < minHeight; i++) {
+    auto& oldLine = oldLines[i];
+    auto& newLine = grid.lines[i];
+    std::copy(oldLine.begin(), oldLine.begin() + minWidth, newLine.begin());
+  }
+  grid.width = width;
+  grid.height = height;
+}
+
+static void BenchScrollAndResize(Arena& arena, int width, int height, int rounds) {
+  auto redraw = MakeRedraw(arena, width, height);
+  rounds *= 10;
+
+  // alternating direction, so every round moves the same cells
+  auto scroll = [&](int r, int left) {
+    return GridScroll{1, 1, height - 1, left, width, r % 2 ? -1 : 1, 0};
+  };
+
+  StringGrid strings(width, height);
+  for (auto& line : redraw) strings.Line(line);
+  double stringMs = TimeMs(rounds, [&](int r) { strings.Scroll(scroll(r, 0)); });
+
+  GridManager grids;
+  grids.Resize({1, width, height});
+  for (auto& line : redraw) grids.Line(line);
+  // a column range can't swap lines, so this is the memmove per line path
+  double copyMs = TimeMs(rounds, [&](int r) { grids.Scroll(scroll(r, 1)); });
+  double swapMs = TimeMs(rounds, [&](int r) { grids.Scroll(scroll(r, 0)); });
+
+  std::println("partial scroll: {}x{} region, {} rounds", width, height - 2, rounds);
+  std::println("string cells copied: {:.2f}us per scroll", stringMs * 1000 / rounds);
+  std::println(
+    "packed cells copied: {:.2f}us per scroll ({:.1f}x)", copyMs * 1000 / rounds,
+    stringMs / copyMs
+  );
+  std::println(
+    "lines swapped:       {:.2f}us per scroll ({:.1f}x)", swapMs * 1000 / rounds,
+    stringMs / swapMs
+  );
+
+  Grid grid{.width = width, .height = height};
+  grid.lines = Grid::Lines(height, Grid::Line(width, Grid::Cell{}));
+  double reallocMs = TimeMs(rounds, [&](int r) {
+    ReallocResize(grid, width, r % 2 ? height : height - 1);
+  });
+  double inPlaceMs = TimeMs(rounds, [&](int r) {
+    grids.Resize({1, width, r % 2 ? height : height - 1});
+  });
+
+  std::println("resize: {}x{} <-> {}x{}, {} rounds", width, height, width, height - 1, rounds);
+  std::println("reallocated: {:.2f}us per resize", reallocMs * 1000 / rounds);
+  std::println(
+    "in place:    {:.2f}us per resize ({:.1f}x)", inPlaceMs * 1000 / rounds,
+    reallocMs / inPlaceMs
+  );
+}
+
+int main(int argc, char* argv[]) {
+  int width = argc > 1 ? std::stoi(argv[1]) : 400;
+  int height = argc > 2 ? std::stoi(argv[2]) : 120;
+  int rounds = argc > 3 ? std::stoi(argv[3]) : 200;
+
+  Arena arena;
+  auto redraw = MakeRedraw(arena, width, height);
+  GridScroll scroll{1, 0, height, 0, width, 1, 0};
+  // partial, so the lines are copied instead of rotating the ring buffer
+  scroll.left = 1;
+
+  StringGrid before(width, height);
+  auto start = steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : redraw) before.Line(line);
+    before.Scroll(scroll);
+    before.Clear();
+  }
+  for (auto& line : redraw) before.Line(line);
+  double beforeMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+  GridManager after;
+  after.Resize({1, width, height});
+  start = steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : redraw) after.Line(line);
+    after.Scroll(scroll);
+    after.Clear({1});
+  }
+  for (auto& line : redraw) after.Line(line);
+  double afterMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+  size_t mismatches = 0;
+  auto& grid = after.grids.at(1);
+  for (int row = 0; row < height; row++) {
+    for (int col = 0; col < width; col++) {
+      auto& a = before.lines[row][col];
+      auto& b = grid.lines[row][col];
+      mismatches += a.text != grid.Text(b) || a.hlId != b.hlId ||
+                    a.doubleWidth != b.doubleWidth;
+    }
+  }
+
+  std::println("full screen redraw: {}x{} cells, {} rounds", width, height, rounds);
+  std::println(
+    "before: {:.3f}ms per redraw ({} byte cells)", beforeMs / rounds, sizeof(StringGrid::Cell)
+  );
+  std::println(
+    "after:  {:.3f}ms per redraw ({} byte cells, {:.1f}x)", afterMs / rounds,
+    sizeof(Grid::Cell), beforeMs / afterMs
+  );
+  if (mismatches > 0) {
+    std::println("mismatch: {} cells differ", mismatches);
+    return 1;
+  }
+
+  std::println();
+  BenchScrollAndResize(arena, width, height, rounds);
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include "event/ui_parse.hpp"
+#include "editor/highlight.hpp"
+#include <chrono>
+#include <map>
+#include <print>
+#include <string>
+#include <vector>
+
+// Colorscheme switch benchmark: one redraw with n hl_attr_define events
+// (like :colorscheme with ext_hlstate info), decoded and applied to an
+// HlManager.
+// before: msgpack object -> maps of variants -> Highlight::FromDesc
+// after:  ParseUiRedraw decoding straight into HlAttrs -> Highlight::FromAttrs
+//
+// usage: hl_attr_bench [attributes] [rounds]
+
+using namespace std::chrono;
+using namespace event;
+
+// hl_attr_define as it was decoded before
+struct HlAttrDefineMaps {
+  int id;
+  HlAttrMap rgbAttrs;
+  HlAttrMap ctermAttrs;
+  std::vector<HlAttrMap> info;
+  MSGPACK_DEFINE(id, rgbAttrs, ctermAttrs, info);
+};
+
+static msgpack::sbuffer PackColorscheme(int numAttrs) {
+  msgpack::sbuffer buffer;
+  msgpack::packer packer(buffer);
+  packer.pack_array(2);
+
+  packer.pack_array(1 + numAttrs);
+  packer.pack("hl_attr_define");
+  for (int id = 1; id <= numAttrs; id++) {
+    std::map<std::string, msgpack::type::variant> rgb{
+      {"foreground", uint64_t(0x102030 * id & 0xffffff)},
+      {"background", uint64_t(0x302010 * id & 0xffffff)},
+    };
+    if (id % 3 == 0) rgb["bold"] = true;
+    if (id % 5 == 0) rgb["italic"] = true;
+    if (id % 7 == 0) rgb["undercurl"] = true;
+    if (id % 11 == 0) rgb["special"] = uint64_t(0xff0000);
+    std::map<std::string, msgpack::type::variant> cterm{{"foreground", uint64_t(id % 256)}};
+    std::vector<std::map<std::string, msgpack::type::variant>> info{{
+      {"kind", std::string("syntax")},
+      {"hi_name", "Group" + std::to_string(id)},
+      {"id", uint64_t(id)},
+    }};
+    packer.pack(std::tuple(id, rgb, cterm, info));
+  }
+
+  packer.pack(std::tuple("flush", std::tuple()));
+  return buffer;
+}
+
+int main(int argc, char* argv[]) {
+  int numAttrs = argc > 1 ? std::stoi(argv[1]) : 3000;
+  int rounds = argc > 2 ? std::stoi(argv[2]) : 50;
+
+  auto params = PackColorscheme(numAttrs);
+
+  double beforeMs = 0;
+  double afterMs = 0;
+  size_t mismatches = 0;
+
+  for (int r = 0; r < rounds; r++) {
+    HlManager before;
+    auto start = steady_clock::now();
+    {
+      auto handle = msgpack::unpack(params.data(), params.size());
+      const auto& event = handle->via.array.ptr[0].via.array;
+      for (uint32_t i = 1; i < event.size; i++) {
+        auto e = event.ptr[i].as<HlAttrDefineMaps>();
+        before.hlTable[e.id] = Highlight::FromDesc(e.rgbAttrs);
+      }
+    }
+    beforeMs += duration<double, std::milli>(steady_clock::now() - start).count();
+
+    HlManager after;
+    UiEvents uiEvents;
+    start = steady_clock::now();
+    {
+      ParseUiRedraw(
+        {params.data(), params.size()}, rpc::ZonePool::Shared().Acquire(), uiEvents
+      );
+      uiEvents.TakeReady();
+      for (auto& batch : uiEvents.queue) {
+        for (auto& event : batch.events) {
+          if (auto* e = std::get_if<HlAttrDefine>(&event)) after.HlAttrDefine(*e);
+        }
+      }
+      uiEvents.Recycle();
+    }
+    afterMs += duration<double, std::milli>(steady_clock::now() - start).count();
+
+    for (int id = 1; id <= numAttrs; id++) {
+      auto& a = before.hlTable[id];
+      auto& b = after.hlTable[id];
+      mismatches += a.foreground != b.foreground || a.background != b.background ||
+                    a.special != b.special || a.bold != b.bold ||
+                    a.italic != b.italic || a.underline != b.underline;
+    }
+  }
+
+  std::println("colorscheme: {} hl_attr_define, {} rounds", numAttrs, rounds);
+  std::println("before: {:.3f}ms per switch (maps of variants)", beforeMs / rounds);
+  std::println(
+    "after:  {:.3f}ms per switch (direct decode, {:.1f}x)", afterMs / rounds,
+    beforeMs / afterMs
+  );
+  if (mismatches > 0) {
+    std::println("mismatch: {} highlights differ", mismatches);
+    return 1;
+  }
+  return 0;
+}
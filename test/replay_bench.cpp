@@ -0,0 +1,130 @@
+#include "nvim/msgpack_rpc/client.hpp"
+#include "event/ui_compact.hpp"
+#include "event/ui_parse.hpp"
+#include "editor/grid.hpp"
+#include "editor/highlight.hpp"
+#include "utils/variant.hpp"
+#include <atomic>
+#include <chrono>
+#include <print>
+#include <string>
+#include <thread>
+
+// Replays an rpc recording (neogurt --record_rpc <path>) with no nvim,
+// window or gpu: redraws are parsed by ParseUiRedraw on the reader thread
+// like a live session, then the grid and highlight events are applied to a
+// GridManager and HlManager on this thread (the cpu side of ProcessUiEvents,
+// including redraw compaction).
+//
+// usage: replay_bench <recording> [realtime]
+
+using namespace std::chrono;
+using namespace event;
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::println("usage: replay_bench <recording> [realtime]");
+    return 1;
+  }
+  std::string path = argv[1];
+  bool realtime = argc > 2 && std::string_view(argv[2]) == "realtime";
+
+  auto uiEvents = std::make_shared<UiEvents>();
+  std::atomic_size_t redrawBytes = 0;
+  std::atomic_int64_t parseNs = 0;
+
+  auto client = std::make_shared<rpc::Client>();
+  client->SetRawNotification("redraw", [&](rpc::Notification&& notif) {
+    auto start = steady_clock::now();
+    redrawBytes += notif.rawParams.size();
+    ParseUiRedraw(notif.rawParams, std::move(notif._zone), *uiEvents);
+    parseNs += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+  });
+
+  auto start = steady_clock::now();
+  if (!client->ConnectReplay(path, realtime)) {
+    std::println("failed to open {}", path);
+    return 1;
+  }
+
+  GridManager gridManager;
+  HlManager hlManager;
+  size_t numBatches = 0;
+  size_t numEvents = 0;
+  nanoseconds applyTime{};
+  GridEventCompactor compactor;
+  GridEventCompactor::Stats compactStats;
+  std::vector<UiEvent*> gridEvents;
+
+  while (true) {
+    // checked first, everything read before the disconnect is ready below
+    bool connected = client->IsConnected();
+
+    uiEvents->TakeReady();
+    auto applyStart = steady_clock::now();
+    for (UiEventBatch& batch : uiEvents->queue) {
+      numBatches++;
+      numEvents += batch.events.size();
+
+      gridEvents.clear();
+      for (UiEvent& event : batch.events) {
+        std::visit(overloaded{
+          [&](DefaultColorsSet& e) { hlManager.DefaultColorsSet(e); },
+          [&](HlAttrDefine& e) { hlManager.HlAttrDefine(e); },
+          [&](GridResize&) { gridEvents.push_back(&event); },
+          [&](GridClear&) { gridEvents.push_back(&event); },
+          [&](GridLine&) { gridEvents.push_back(&event); },
+          [&](GridScroll&) { gridEvents.push_back(&event); },
+          [&](GridDestroy&) { gridEvents.push_back(&event); },
+          [&](auto&) {},
+        }, event);
+      }
+
+      auto stats = compactor.Compact(gridEvents, batch.arena);
+      compactStats.droppedEvents += stats.droppedEvents;
+      compactStats.droppedCells += stats.droppedCells;
+      for (UiEvent* event : gridEvents) {
+        std::visit(overloaded{
+          [&](GridResize& e) { gridManager.Resize(e); },
+          [&](GridClear& e) { gridManager.Clear(e); },
+          [&](GridLine& e) { gridManager.Line(e); },
+          [&](GridScroll& e) { gridManager.Scroll(e); },
+          [&](GridDestroy& e) { gridManager.Destroy(e); },
+          [&](auto&) {},
+        }, *event);
+      }
+    }
+    uiEvents->Recycle();
+    applyTime += steady_clock::now() - applyStart;
+
+    // other notifications and requests aren't part of the benchmark
+    client->DrainMessages([](rpc::Message&) {});
+
+    if (!connected) break;
+    std::this_thread::yield();
+  }
+  auto end = steady_clock::now();
+
+  double elapsed = duration<double>(end - start).count();
+  double parse = parseNs / 1e6;
+  double apply = duration<double, std::milli>(applyTime).count();
+
+  std::println("recording:  {} ({})", path, realtime ? "realtime" : "max speed");
+  std::println(
+    "redraw:     {:.2f} MB, {} batches, {} events",
+    redrawBytes / 1e6, numBatches, numEvents
+  );
+  std::println("wall time:  {:.1f}ms", elapsed * 1e3);
+  std::println(
+    "parse:      {:.1f}ms ({:.1f} MB/s)", parse, redrawBytes / 1e6 / (parse / 1e3)
+  );
+  std::println(
+    "apply:      {:.1f}ms ({:.2f}us per batch)", apply,
+    numBatches ? apply * 1e3 / numBatches : 0.0
+  );
+  std::println(
+    "compacted:  {} grid events, {} cells dropped",
+    compactStats.droppedEvents, compactStats.droppedCells
+  );
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "nvim/msgpack_rpc/response_table.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <print>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Call -> response matching at different in-flight counts.
+// One thread registers calls like Client::Call, another completes them in
+// msgid order like the reader thread, at most inFlight calls apart.
+// Compares rpc::ResponseTable with the previous unordered_map + mutex.
+//
+// usage: response_table_bench [calls]
+
+using namespace std::chrono;
+
+struct MapTable {
+  std::unordered_map<uint32_t, std::promise<msgpack::object_handle>> responses;
+  std::mutex mutex;
+
+  void Register(uint32_t msgid, std::promise<msgpack::object_handle>&& promise) {
+    std::scoped_lock lock(mutex);
+    responses[msgid] = std::move(promise);
+  }
+  bool Complete(uint32_t msgid) {
+    std::promise<msgpack::object_handle> promise;
+    {
+      std::scoped_lock lock(mutex);
+      auto it = responses.find(msgid);
+      if (it == responses.end()) return false;
+      promise = std::move(it->second);
+      responses.erase(it);
+    }
+    promise.set_value({});
+    return true;
+  }
+};
+
+struct RingTable {
+  rpc::ResponseTable responses;
+
+  void Register(uint32_t msgid, std::promise<msgpack::object_handle>&& promise) {
+    responses.Register(msgid, std::move(promise));
+  }
+  bool Complete(uint32_t msgid) {
+    auto call = responses.Take(msgid);
+    if (!call) return false;
+    call->promise.set_value({});
+    return true;
+  }
+};
+
+// returns nanoseconds per call
+template <typename Table>
+double Run(uint32_t calls, uint32_t inFlight) {
+  Table table;
+  std::atomic_uint32_t registered = 0;
+  std::atomic_uint32_t completed = 0;
+  uint32_t missing = 0;
+
+  auto start = steady_clock::now();
+  std::jthread reader([&] {
+    for (uint32_t i = 0; i < calls; i++) {
+      while (registered.load(std::memory_order_acquire) <= i) {
+        std::this_thread::yield();
+      }
+      if (!table.Complete(i)) missing++;
+      completed.store(i + 1, std::memory_order_release);
+    }
+  });
+  for (uint32_t i = 0; i < calls; i++) {
+    while (i - completed.load(std::memory_order_acquire) >= inFlight) {
+      std::this_thread::yield();
+    }
+    table.Register(i, {});
+    registered.store(i + 1, std::memory_order_release);
+  }
+  reader.join();
+  auto end = steady_clock::now();
+
+  if (missing != 0) std::println("  {} responses not matched", missing);
+  return duration<double, std::nano>(end - start).count() / calls;
+}
+
+int main(int argc, char* argv[]) {
+  uint32_t calls = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+
+  std::println("{:>10} {:>14} {:>14}", "in flight", "map+mutex", "ring");
+  for (uint32_t inFlight : {1u, 16u, 256u, 4096u, 65536u}) {
+    double map = Run<MapTable>(calls, inFlight);
+    double ring = Run<RingTable>(calls, inFlight);
+    std::println("{:>10} {:>11.1f}ns {:>11.1f}ns", inFlight, map, ring);
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+#include "nvim/msgpack_rpc/client.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/write.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Round trip benchmark for requests sent to the client (nvim -> neogurt),
+// the path rpcrequest(chan, 'neogurt_cmd', ...) takes.
+// A tcp peer stands in for nvim and sends requests at a fixed rate,
+// the client answers them like EventManager::ProcessSessionEvents.
+//
+// usage: rpc_bench [requests per second] [seconds]
+
+using namespace std::chrono;
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+int main(int argc, char* argv[]) {
+  int rate = argc > 1 ? std::stoi(argv[1]) : 10000;
+  int seconds = argc > 2 ? std::stoi(argv[2]) : 3;
+  int total = rate * seconds;
+
+  asio::io_context context;
+  tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+  tcp::socket peer(context);
+
+  auto client = std::make_shared<rpc::Client>();
+  std::jthread acceptThread([&] { acceptor.accept(peer); });
+  if (!client->ConnectTcp("127.0.0.1", acceptor.local_endpoint().port())) {
+    std::println("failed to connect");
+    return 1;
+  }
+  acceptThread.join();
+
+  std::atomic_bool done = false;
+  std::jthread handler([&] {
+    while (!done) {
+      if (!client->HasMessage()) {
+        std::this_thread::yield();
+        continue;
+      }
+      auto& request = std::get<rpc::Request>(client->FrontMessage());
+      request.SetResult(request.params);
+      client->PopMessage();
+    }
+  });
+
+  std::vector<steady_clock::time_point> sent(total);
+  std::vector<steady_clock::time_point> received(total);
+
+  std::jthread reader([&] {
+    constexpr size_t readSize = 1 << 16;
+    msgpack::unpacker unpacker;
+    int count = 0;
+    while (count < total) {
+      unpacker.reserve_buffer(readSize);
+      boost::system::error_code ec;
+      size_t length = peer.read_some(asio::buffer(unpacker.buffer(), readSize), ec);
+      if (ec) break;
+      unpacker.buffer_consumed(length);
+
+      msgpack::object_handle handle;
+      while (unpacker.next(handle)) {
+        auto now = steady_clock::now();
+        rpc::ResponseIn response(handle.get().convert());
+        received[response.msgid] = now;
+        count++;
+      }
+    }
+  });
+
+  auto start = steady_clock::now();
+  auto interval = duration_cast<nanoseconds>(1s) / rate;
+  for (int i = 0; i < total; i++) {
+    std::this_thread::sleep_until(start + interval * i);
+
+    rpc::RequestOut msg{
+      .msgid = uint32_t(i),
+      .method = "neogurt_cmd",
+      .params = std::tuple("bench", i),
+    };
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, msg);
+
+    sent[i] = steady_clock::now();
+    asio::write(peer, asio::buffer(buffer.data(), buffer.size()));
+  }
+  reader.join();
+  auto end = steady_clock::now();
+  done = true;
+
+  std::vector<double> latencies;
+  latencies.reserve(total);
+  for (int i = 0; i < total; i++) {
+    if (received[i] == steady_clock::time_point{}) continue;
+    latencies.push_back(duration<double, std::micro>(received[i] - sent[i]).count());
+  }
+  if (latencies.empty()) {
+    std::println("no responses received");
+    return 1;
+  }
+  std::ranges::sort(latencies);
+
+  auto Percentile = [&](double p) {
+    return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+  };
+  double elapsed = duration<double>(end - start).count();
+
+  std::println("requests:   {} / {} answered", latencies.size(), total);
+  std::println("throughput: {:.0f} req/s (target {})", latencies.size() / elapsed, rate);
+  std::println(
+    "round trip: p50 {:.1f}us, p90 {:.1f}us, p99 {:.1f}us, max {:.1f}us",
+    Percentile(0.5), Percentile(0.9), Percentile(0.99), latencies.back()
+  );
+
+  client->TryDisconnect();
+  peer.close();
+  return 0;
+}
@@ -0,0 +1,167 @@
+#define BOOST_TEST_MODULE RpcLoadTest
+#include <boost/test/included/unit_test.hpp>
+
+#include "nvim/msgpack_rpc/client.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/process/v1/child.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Load tests rpc::Client against test/fake_nvim under a few traffic profiles,
+// over each transport. Run with --log_level=message to see the numbers.
+
+using namespace std::chrono;
+namespace asio = boost::asio;
+namespace bp = boost::process::v1;
+
+struct Profile {
+  std::string name;
+  std::string serverArgs;
+  int callRate; // client calls per second
+};
+
+static const Profile typing{
+  "typing", "--width 80 --height 24 --lines 1 --cells 80 --rate 120", 120
+};
+static const Profile scrolling{
+  "scrolling", "--width 200 --height 60 --lines 60 --cells 200 --rate 60", 60
+};
+// lots of float redraws while a slow plugin answers neogurt requests
+static const Profile floatStorm{
+  "float storm",
+  "--width 400 --height 120 --lines 120 --cells 400 --rate 0 --latency_us 500 "
+  "--request_every 10",
+  500,
+};
+
+enum class Transport { Stdio, Tcp, Unix };
+
+static const char* TransportName(Transport transport) {
+  switch (transport) {
+    case Transport::Stdio: return "stdio";
+    case Transport::Tcp: return "tcp";
+    case Transport::Unix: return "unix";
+  }
+  return "";
+}
+
+static void RunProfile(const Profile& profile, Transport transport) {
+  constexpr auto runTime = 1s;
+
+  std::atomic_size_t numRedraws = 0;
+  std::atomic_size_t redrawBytes = 0;
+  auto client = std::make_shared<rpc::Client>();
+  client->SetRawNotification("redraw", [&](rpc::Notification&& notif) {
+    numRedraws++;
+    redrawBytes += notif.rawParams.size();
+  });
+
+  bp::child server;
+  if (transport == Transport::Stdio) {
+    auto command = std::format("{} --stdio {}", FAKE_NVIM_PATH, profile.serverArgs);
+    BOOST_REQUIRE(client->ConnectStdio(command, false));
+  } else if (transport == Transport::Unix) {
+    auto path = (std::filesystem::temp_directory_path() / "neogurt_fake_nvim.sock").string();
+    std::filesystem::remove(path);
+    auto args = std::format("--unix {} {}", path, profile.serverArgs);
+    server = bp::child(std::format("{} {}", FAKE_NVIM_PATH, args));
+
+    auto deadline = steady_clock::now() + 2s;
+    while (!client->ConnectUnixSocket(path) && steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(10ms);
+    }
+    BOOST_REQUIRE(client->IsConnected());
+  } else {
+    // find a free port, then let the server listen on it
+    uint16_t port;
+    {
+      asio::io_context context;
+      asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+      port = acceptor.local_endpoint().port();
+    }
+    auto args = std::format("--tcp {} {}", port, profile.serverArgs);
+    server = bp::child(std::format("{} {}", FAKE_NVIM_PATH, args));
+
+    auto deadline = steady_clock::now() + 2s;
+    while (!client->ConnectTcp("127.0.0.1", port) && steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(10ms);
+    }
+    BOOST_REQUIRE(client->IsConnected());
+  }
+
+  // calls from their own thread, the message queue is drained below
+  std::vector<double> latencies;
+  std::atomic_bool stop = false;
+  std::jthread caller([&] {
+    auto start = steady_clock::now();
+    auto interval = duration_cast<nanoseconds>(1s) / profile.callRate;
+    for (int i = 0; !stop; i++) {
+      std::this_thread::sleep_until(start + interval * i);
+      auto sent = steady_clock::now();
+      auto future = client->Call({.timeout = 2s}, "nvim_input", "x");
+      try {
+        future.get();
+        auto latency = duration<double, std::micro>(steady_clock::now() - sent);
+        latencies.push_back(latency.count());
+      } catch (const std::exception&) {
+        break;
+      }
+    }
+  });
+
+  auto start = steady_clock::now();
+  size_t numMessages = 0;
+  while (steady_clock::now() - start < runTime) {
+    numMessages += client->DrainMessages([](rpc::Message& message) {
+      if (auto* request = std::get_if<rpc::Request>(&message)) {
+        request->SetResult(true);
+      }
+    });
+    std::this_thread::sleep_for(1ms);
+  }
+  stop = true;
+  caller.join();
+  double elapsed = duration<double>(steady_clock::now() - start).count();
+
+  client->TryDisconnect();
+  client.reset();
+  if (server.valid()) server.wait();
+
+  BOOST_REQUIRE(!latencies.empty());
+  BOOST_CHECK_GT(numRedraws, 0u);
+
+  std::ranges::sort(latencies);
+  auto Percentile = [&](double p) {
+    return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+  };
+  BOOST_TEST_MESSAGE(std::format(
+    "{} ({}): {:.0f} redraws/s, {:.1f} MB/s, {} other messages, "
+    "{} calls p50 {:.0f}us p90 {:.0f}us p99 {:.0f}us",
+    profile.name, TransportName(transport),
+    numRedraws / elapsed, redrawBytes / elapsed / 1e6, numMessages,
+    latencies.size(), Percentile(0.5), Percentile(0.9), Percentile(0.99)
+  ));
+}
+
+BOOST_AUTO_TEST_CASE(Typing) {
+  RunProfile(typing, Transport::Stdio);
+  RunProfile(typing, Transport::Tcp);
+  RunProfile(typing, Transport::Unix);
+}
+
+BOOST_AUTO_TEST_CASE(Scrolling) {
+  RunProfile(scrolling, Transport::Stdio);
+  RunProfile(scrolling, Transport::Tcp);
+  RunProfile(scrolling, Transport::Unix);
+}
+
+BOOST_AUTO_TEST_CASE(FloatStorm) {
+  RunProfile(floatStorm, Transport::Stdio);
+  RunProfile(floatStorm, Transport::Tcp);
+  RunProfile(floatStorm, Transport::Unix);
+}
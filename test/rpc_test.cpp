@@ -0,0 +1,698 @@
+#define BOOST_TEST_MODULE RpcTest
+#include <boost/test/included/unit_test.hpp>
+
+#include "nvim/api.hpp"
+#include "nvim/msgpack_rpc/client.hpp"
+#include "nvim/msgpack_rpc/pool.hpp"
+#include "nvim/msgpack_rpc/response_table.hpp"
+#include "event/ui_parse.hpp"
+#include "utils/arena.hpp"
+#include "utils/spsc_queue.hpp"
+#include "utils/timer_wheel.hpp"
+#include "utils/trace.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/write.hpp"
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+// Stands in for nvim: answers every request with its params,
+// and sends one request to the client on connect.
+struct EchoServer {
+  asio::io_context context;
+  tcp::acceptor acceptor{context, {asio::ip::address_v4::loopback(), 0}};
+  std::vector<std::jthread> connections;
+  std::jthread acceptThread;
+  std::atomic_int clientResponses = 0;
+
+  EchoServer(int numConnections) {
+    acceptThread = std::jthread([this, numConnections] {
+      for (int i = 0; i < numConnections; i++) {
+        auto socket = std::make_shared<tcp::socket>(context);
+        acceptor.accept(*socket);
+        connections.emplace_back([this, socket] { Serve(*socket); });
+      }
+    });
+  }
+
+  uint16_t Port() { return acceptor.local_endpoint().port(); }
+
+  void Serve(tcp::socket& socket) {
+    {
+      rpc::RequestOut msg{.msgid = 0, .method = "neogurt_cmd", .params = std::tuple(1)};
+      msgpack::sbuffer buffer;
+      msgpack::pack(buffer, msg);
+      asio::write(socket, asio::buffer(buffer.data(), buffer.size()));
+    }
+
+    msgpack::unpacker unpacker;
+    while (true) {
+      unpacker.reserve_buffer(1 << 16);
+      boost::system::error_code ec;
+      size_t length = socket.read_some(asio::buffer(unpacker.buffer(), 1 << 16), ec);
+      if (ec) return;
+      unpacker.buffer_consumed(length);
+
+      msgpack::sbuffer out;
+      msgpack::object_handle handle;
+      while (unpacker.next(handle)) {
+        int type = handle.get().via.array.ptr[0].convert();
+        if (type == rpc::MessageType::Response) {
+          clientResponses++;
+          continue;
+        }
+        rpc::RequestIn request(handle.get().convert());
+        msgpack::pack(out, rpc::ResponseOut{.msgid = request.msgid, .result = request.params});
+      }
+      asio::write(socket, asio::buffer(out.data(), out.size()), ec);
+      if (ec) return;
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(SharedReactor50Sessions) {
+  constexpr int numSessions = 50;
+  constexpr int numCalls = 200;
+
+  EchoServer server(numSessions);
+  auto& reactor = rpc::Reactor::Shared();
+
+  std::vector<std::shared_ptr<rpc::Client>> clients;
+  for (int i = 0; i < numSessions; i++) {
+    auto client = std::make_shared<rpc::Client>(&reactor);
+    BOOST_REQUIRE(client->ConnectTcp("127.0.0.1", server.Port()));
+    clients.push_back(std::move(client));
+  }
+
+  // interleave calls across all sessions
+  std::vector<std::vector<std::future<msgpack::object_handle>>> futures(numSessions);
+  for (int j = 0; j < numCalls; j++) {
+    for (int i = 0; i < numSessions; i++) {
+      futures[i].push_back(clients[i]->Call("echo", i, j));
+    }
+  }
+
+  for (int i = 0; i < numSessions; i++) {
+    for (int j = 0; j < numCalls; j++) {
+      BOOST_REQUIRE(futures[i][j].wait_for(5s) == std::future_status::ready);
+      auto [session, call] = futures[i][j].get()->as<std::tuple<int, int>>();
+      BOOST_CHECK_EQUAL(session, i);
+      BOOST_CHECK_EQUAL(call, j);
+    }
+  }
+
+  // answer the server's request on every session
+  for (auto& client : clients) {
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!client->HasMessage() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(1ms);
+    }
+    BOOST_REQUIRE(client->HasMessage());
+    std::get<rpc::Request>(client->FrontMessage()).SetResult(true);
+    client->PopMessage();
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (server.clientResponses < numSessions && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_CHECK_EQUAL(server.clientResponses, numSessions);
+
+  for (auto& client : clients) {
+    client->TryDisconnect();
+    BOOST_CHECK(!client->IsConnected());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FullQueueDoesNotBlockReactor) {
+  constexpr int numNotes = 3000; // more than the message queue holds
+
+  // floods notifications and never reads
+  asio::io_context context;
+  tcp::acceptor acceptor{context, {asio::ip::address_v4::loopback(), 0}};
+  std::jthread flood([&] {
+    tcp::socket socket(context);
+    acceptor.accept(socket);
+    msgpack::sbuffer buffer;
+    for (int i = 0; i < numNotes; i++) {
+      msgpack::pack(buffer, std::tuple(2, "note", std::tuple(i)));
+    }
+    boost::system::error_code ec;
+    asio::write(socket, asio::buffer(buffer.data(), buffer.size()), ec);
+    // open until the client disconnects
+    char byte;
+    socket.read_some(asio::buffer(&byte, 1), ec);
+  });
+  EchoServer server(1);
+
+  auto& reactor = rpc::Reactor::Shared();
+  auto full = std::make_shared<rpc::Client>(&reactor);
+  BOOST_REQUIRE(full->ConnectTcp("127.0.0.1", acceptor.local_endpoint().port()));
+  auto other = std::make_shared<rpc::Client>(&reactor);
+  BOOST_REQUIRE(other->ConnectTcp("127.0.0.1", server.Port()));
+
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (full->MessageQueueStats().fullCount == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_REQUIRE_EQUAL(full->MessageQueueStats().fullCount, 1u);
+
+  // the full client's reads are paused, the reactor still serves the other
+  auto result = other->Call("echo", 7);
+  BOOST_REQUIRE(result.wait_for(5s) == std::future_status::ready);
+  BOOST_CHECK_EQUAL(std::get<0>(result.get()->as<std::tuple<int>>()), 7);
+
+  // draining resumes reading, nothing is lost or reordered
+  int next = 0;
+  deadline = std::chrono::steady_clock::now() + 5s;
+  while (next < numNotes && std::chrono::steady_clock::now() < deadline) {
+    full->DrainMessages([&](rpc::Message& message) {
+      auto& notification = std::get<rpc::Notification>(message);
+      BOOST_REQUIRE_EQUAL(notification.method, "note");
+      BOOST_REQUIRE_EQUAL(std::get<0>(notification.params.as<std::tuple<int>>()), next);
+      next++;
+    });
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_CHECK_EQUAL(next, numNotes);
+
+  full->TryDisconnect();
+  other->TryDisconnect();
+}
+
+BOOST_AUTO_TEST_CASE(SpscQueueOrder) {
+  constexpr int count = 100000;
+  SpscQueue<std::string> queue(64);
+
+  std::jthread producer([&] {
+    for (int i = 0; i < count; i++) {
+      std::string value = std::to_string(i);
+      while (!queue.TryPush(std::move(value))) std::this_thread::yield();
+    }
+  });
+
+  // alternate single pops and drains
+  int next = 0;
+  bool inOrder = true;
+  while (next < count) {
+    if (next % 2 == 0) {
+      if (auto* value = queue.Front()) {
+        inOrder &= *value == std::to_string(next++);
+        queue.Pop();
+      }
+    } else {
+      queue.Drain([&](std::string& value) {
+        inOrder &= value == std::to_string(next++);
+      });
+    }
+  }
+
+  BOOST_CHECK(inOrder);
+  BOOST_CHECK(queue.Empty());
+  BOOST_CHECK_LE(queue.MaxDepth(), queue.Capacity());
+}
+
+BOOST_AUTO_TEST_CASE(CallTimeoutAndCancel) {
+  // peer that never responds
+  asio::io_context context;
+  tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+  tcp::socket peer(context);
+  std::jthread acceptThread([&] { acceptor.accept(peer); });
+
+  auto client = std::make_shared<rpc::Client>();
+  BOOST_REQUIRE(client->ConnectTcp("127.0.0.1", acceptor.local_endpoint().port()));
+  acceptThread.join();
+
+  auto timedOut = client->Call({.timeout = 50ms}, "never");
+  BOOST_REQUIRE(timedOut.wait_for(2s) == std::future_status::ready);
+  BOOST_CHECK_THROW(timedOut.get(), rpc::CallAborted);
+
+  std::stop_source stopSource;
+  auto cancelled = client->Call({.stopToken = stopSource.get_token()}, "never");
+  BOOST_CHECK(cancelled.wait_for(50ms) == std::future_status::timeout);
+  stopSource.request_stop();
+  BOOST_REQUIRE(cancelled.wait_for(0s) == std::future_status::ready);
+  BOOST_CHECK_THROW(cancelled.get(), rpc::CallAborted);
+
+  // pending calls fail on disconnect
+  auto pending = client->Call("never");
+  client->TryDisconnect();
+  BOOST_REQUIRE(pending.wait_for(0s) == std::future_status::ready);
+  BOOST_CHECK_THROW(pending.get(), rpc::CallAborted);
+}
+
+BOOST_AUTO_TEST_CASE(TimerWheelNeverEarly) {
+  using Clock = TimerWheel::Clock;
+  constexpr int numTimers = 40;
+  TimerWheel wheel(10ms);
+
+  // keeps the wheel running, so timers get scheduled mid tick
+  wheel.Schedule(10s, [] {});
+
+  struct Fired {
+    Clock::time_point due;
+    std::atomic<Clock::rep> early = 0; // how early it fired, 0 if on time
+    std::atomic_bool done = false;
+  };
+  std::vector<Fired> fired(numTimers);
+  for (int i = 0; i < numTimers; i++) {
+    // offsets that don't line up with the tick
+    std::this_thread::sleep_for(std::chrono::microseconds(1700 + 300 * (i % 7)));
+    auto delay = std::chrono::milliseconds(1 + i % 25);
+    fired[i].due = Clock::now() + delay;
+    wheel.Schedule(delay, [&fired = fired[i]] {
+      auto early = fired.due - Clock::now();
+      fired.early = std::max(early, Clock::duration(0)).count();
+      fired.done = true;
+    });
+  }
+
+  auto deadline = Clock::now() + 5s;
+  for (auto& timer : fired) {
+    while (!timer.done && Clock::now() < deadline) {
+      std::this_thread::sleep_for(1ms);
+    }
+    BOOST_REQUIRE(timer.done);
+    BOOST_CHECK_EQUAL(timer.early, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ResponseTableGrow) {
+  rpc::ResponseTable table(4);
+
+  // more calls in flight than slots
+  std::vector<std::future<msgpack::object_handle>> futures;
+  for (uint32_t msgid = 0; msgid < 10; msgid++) {
+    std::promise<msgpack::object_handle> promise;
+    futures.push_back(promise.get_future());
+    table.Register(msgid, std::move(promise));
+  }
+  BOOST_CHECK_GE(table.Capacity(), 16u);
+
+  for (uint32_t msgid = 1; msgid < 10; msgid += 2) {
+    auto call = table.Take(msgid);
+    BOOST_REQUIRE(call);
+    call->promise.set_value({});
+  }
+  BOOST_CHECK(!table.Take(1));
+  BOOST_CHECK(!table.Take(10));
+
+  // a slot freed by a completed call is reused without growing
+  size_t capacity = table.Capacity();
+  table.Register(1 + capacity, {});
+  BOOST_CHECK_EQUAL(table.Capacity(), capacity);
+
+  auto pending = table.TakeAll();
+  BOOST_CHECK_EQUAL(pending.size(), 6u);
+  for (auto& [msgid, call] : pending) {
+    BOOST_CHECK(msgid % 2 == 0 || msgid == 1 + capacity);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PoolsReuse) {
+  rpc::ZonePool zones(4);
+  rpc::BufferPool buffers(4);
+
+  // steady state, one message in flight at a time
+  for (int i = 0; i < 100; i++) {
+    auto zone = zones.Acquire();
+    zone->allocate_align(64);
+
+    auto buffer = buffers.Acquire();
+    msgpack::pack(buffer, std::tuple(i, "message"));
+    buffers.Release(std::move(buffer));
+  }
+  BOOST_CHECK_EQUAL(zones.Stats().created, 1u);
+  BOOST_CHECK_EQUAL(zones.Stats().recycled, 100u);
+  BOOST_CHECK_EQUAL(buffers.Stats().created, 1u);
+
+  // more in flight than the pool keeps
+  std::vector<rpc::PooledZone> held;
+  for (int i = 0; i < 6; i++) held.push_back(zones.Acquire());
+  held.clear();
+  BOOST_CHECK_EQUAL(zones.Stats().dropped, 2u);
+
+  // array results keep no pooled zone, every one acquired comes back
+  EchoServer server(1);
+  auto client = std::make_shared<rpc::Client>();
+  BOOST_REQUIRE(client->ConnectTcp("127.0.0.1", server.Port()));
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!client->HasMessage() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_REQUIRE(client->HasMessage());
+  client->PopMessage();
+
+  auto before = rpc::ZonePool::Shared().Stats();
+  std::vector<msgpack::object_handle> results;
+  for (int i = 0; i < 20; i++) {
+    auto future = client->Call("echo", i, "result");
+    BOOST_REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    results.push_back(future.get());
+  }
+
+  // the reader releases a zone just after completing its call
+  size_t inUse = 0; // results are held, but not in pooled zones
+  auto returned = [&] {
+    auto after = rpc::ZonePool::Shared().Stats();
+    return after.recycled - before.recycled + after.dropped - before.dropped + inUse;
+  };
+  deadline = std::chrono::steady_clock::now() + 5s;
+  while (returned() != rpc::ZonePool::Shared().Stats().acquired - before.acquired &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_CHECK_EQUAL(rpc::ZonePool::Shared().Stats().acquired - before.acquired, returned());
+  BOOST_CHECK_GE(returned(), 20u);
+  client->TryDisconnect();
+
+  for (int i = 0; i < 20; i++) {
+    auto [value, str] = results[i]->as<std::tuple<int, std::string>>();
+    BOOST_CHECK_EQUAL(value, i);
+    BOOST_CHECK_EQUAL(str, "result");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TakeWritesPriorityAndCap) {
+  constexpr size_t maxWrite = rpc::Client::maxNormalWrite;
+  auto makeBuffer = [](size_t size, char tag) {
+    msgpack::sbuffer buffer;
+    std::string bytes(size, tag);
+    buffer.write(bytes.data(), bytes.size());
+    return buffer;
+  };
+
+  rpc::Client::OutQueue queue;
+  // 10 normal messages of a quarter of the limit each
+  for (int i = 0; i < 10; i++) {
+    queue.normal.push_back(makeBuffer(maxWrite / 4, char('a' + i)));
+  }
+  queue.priority.push_back(makeBuffer(16, 'x'));
+  queue.priority.push_back(makeBuffer(16, 'y'));
+
+  std::vector<msgpack::sbuffer> out;
+  rpc::Client::TakeWrites(queue, out);
+  // priority first, then normal in order up to the limit
+  BOOST_REQUIRE_EQUAL(out.size(), 6u);
+  BOOST_CHECK_EQUAL(out[0].data()[0], 'x');
+  BOOST_CHECK_EQUAL(out[1].data()[0], 'y');
+  size_t normalSize = 0;
+  for (size_t i = 2; i < out.size(); i++) {
+    BOOST_CHECK_EQUAL(out[i].data()[0], char('a' + i - 2));
+    normalSize += out[i].size();
+  }
+  BOOST_CHECK_LE(normalSize, maxWrite);
+  BOOST_CHECK(queue.priority.empty());
+  BOOST_CHECK_EQUAL(queue.normal.size(), 6u);
+
+  // priority queued later still goes ahead of the rest
+  queue.priority.push_back(makeBuffer(16, 'z'));
+  out.clear();
+  rpc::Client::TakeWrites(queue, out);
+  BOOST_REQUIRE_EQUAL(out.size(), 5u);
+  BOOST_CHECK_EQUAL(out[0].data()[0], 'z');
+  BOOST_CHECK_EQUAL(out[1].data()[0], 'e');
+  BOOST_CHECK_EQUAL(out[4].data()[0], 'h');
+
+  // a single message over the limit goes out whole, on its own
+  queue.normal.clear();
+  queue.normal.push_back(makeBuffer(maxWrite * 2, 'b'));
+  queue.normal.push_back(makeBuffer(16, 'c'));
+  out.clear();
+  rpc::Client::TakeWrites(queue, out);
+  BOOST_REQUIRE_EQUAL(out.size(), 1u);
+  BOOST_CHECK_EQUAL(out[0].size(), maxWrite * 2);
+  BOOST_CHECK_EQUAL(queue.normal.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(RecordAndReplay) {
+  auto path = (std::filesystem::temp_directory_path() / "neogurt_rpc_test.rec").string();
+
+  // a notification split across two reads, then a request
+  msgpack::sbuffer stream;
+  msgpack::pack(stream, rpc::NotificationOut{.method = "redraw", .params = std::tuple(1, 2)});
+  size_t split = stream.size() / 2;
+  msgpack::pack(
+    stream, rpc::RequestOut{.msgid = 7, .method = "neogurt_cmd", .params = std::tuple()}
+  );
+  {
+    rpc::Recorder recorder;
+    BOOST_REQUIRE(recorder.Open(path));
+    recorder.Write({stream.data(), split});
+    recorder.Write({stream.data() + split, stream.size() - split});
+  }
+
+  std::vector<std::tuple<int, int>> redraws;
+  auto client = std::make_shared<rpc::Client>();
+  client->SetRawNotification("redraw", [&](rpc::Notification&& notif) {
+    auto handle = msgpack::unpack(notif.rawParams.data(), notif.rawParams.size());
+    redraws.push_back(handle->as<std::tuple<int, int>>());
+  });
+  BOOST_REQUIRE(client->ConnectReplay(path));
+
+  // disconnects at the end of the recording
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (client->IsConnected() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  BOOST_REQUIRE(!client->IsConnected());
+
+  BOOST_REQUIRE_EQUAL(redraws.size(), 1u);
+  BOOST_CHECK(redraws[0] == std::tuple(1, 2));
+  BOOST_REQUIRE(client->HasMessage());
+  BOOST_CHECK_EQUAL(std::get<rpc::Request>(client->FrontMessage()).method, "neogurt_cmd");
+  client->PopMessage();
+
+  std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TypedApiCall) {
+  EchoServer server(1);
+  auto client = std::make_shared<rpc::Client>();
+  BOOST_REQUIRE(client->ConnectTcp("127.0.0.1", server.Port()));
+
+  // the echo server answers with the params, so they come back as the result
+  api::Future<std::tuple<int, int>> resize{client->Call({}, api::UiTryResize{3, 4})};
+  BOOST_REQUIRE(resize.wait_for(5s) == std::future_status::ready);
+  BOOST_CHECK(resize.get() == std::tuple(3, 4));
+
+  std::map<std::string_view, api::ObjectRef> opts{{"name", "Normal"}};
+  api::Future<api::Array> getHl{client->Call({}, api::GetHl{0, opts})};
+  auto params = getHl.get();
+  BOOST_REQUIRE_EQUAL(params.size(), 2u);
+  BOOST_CHECK_EQUAL(params[0].as_uint64_t(), 0u);
+
+  // window handles arrive as ext types
+  msgpack::sbuffer payload;
+  msgpack::pack(payload, 1000);
+  msgpack::zone zone;
+  msgpack::object ext(msgpack::type::ext(1, payload.data(), payload.size()), zone);
+  BOOST_CHECK_EQUAL(ext.as<api::Handle>().id, 1000);
+
+  client->TryDisconnect();
+}
+
+BOOST_AUTO_TEST_CASE(ArenaReset) {
+  Arena arena(256);
+  std::string_view text = arena.Copy("grid_line");
+  auto cells = arena.MakeArray<event::GridLine::Cell>(100);
+  BOOST_CHECK_EQUAL(text, "grid_line");
+  BOOST_CHECK(!cells.back().hlId);
+  size_t capacity = arena.Capacity();
+  BOOST_CHECK_GT(capacity, 256u);
+
+  // chunks are merged on reset, the same allocations then fit without growing
+  for (int i = 0; i < 3; i++) {
+    arena.Reset();
+    arena.Copy("grid_line");
+    arena.MakeArray<event::GridLine::Cell>(100);
+    BOOST_CHECK_EQUAL(arena.Capacity(), capacity);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReaderReadsTypes) {
+  msgpack::sbuffer buffer;
+  msgpack::pack(buffer, std::tuple(
+    -1, 200, -40000, uint64_t(1) << 40, 1.5, 3, true, msgpack::type::nil_t(),
+    std::string(300, 'x'), std::map<std::string, int>{{"k", 1}}
+  ));
+
+  rpc::Reader reader(buffer.data(), buffer.size());
+  BOOST_CHECK_EQUAL(reader.ReadArray(), 10u);
+  BOOST_CHECK_EQUAL(reader.ReadInt(), -1);
+  BOOST_CHECK_EQUAL(reader.ReadInt(), 200);
+  BOOST_CHECK_EQUAL(reader.ReadInt(), -40000);
+  BOOST_CHECK_EQUAL(reader.ReadInt(), int64_t(1) << 40);
+  BOOST_CHECK_EQUAL(reader.ReadFloat(), 1.5);
+  // whole numbers come as ints
+  BOOST_CHECK_EQUAL(reader.ReadFloat(), 3.0);
+  BOOST_CHECK(reader.ReadBool());
+  BOOST_CHECK(reader.IsNil());
+  reader.ReadNil();
+  BOOST_CHECK_EQUAL(reader.ReadStr(), std::string(300, 'x'));
+  BOOST_CHECK_EQUAL(reader.ReadMap(), 1u);
+  BOOST_CHECK_EQUAL(reader.ReadStr(), "k");
+  BOOST_CHECK_THROW(reader.ReadStr(), msgpack::type_error);
+  BOOST_CHECK(reader.Empty());
+  BOOST_CHECK_THROW(reader.ReadInt(), msgpack::insufficient_bytes);
+}
+
+static msgpack::sbuffer PackRedraw() {
+  msgpack::sbuffer buffer;
+  msgpack::pack(buffer, std::tuple(2, "redraw", std::tuple(
+    std::tuple("grid_line", std::tuple(1, 2, 1, std::tuple(
+      std::tuple("a", 3), std::tuple("字"), std::tuple(""), std::tuple(" ", 0, 70000)
+    ), true)),
+    std::tuple("grid_scroll", std::tuple(1, 0, 10, 0, 20, -3, 0)),
+    std::tuple("flush", std::tuple())
+  )));
+  return buffer;
+}
+
+BOOST_AUTO_TEST_CASE(ReaderSkipSplitAnywhere) {
+  auto message = PackRedraw();
+  std::string bytes(message.data(), message.size());
+  size_t size = bytes.size();
+  bytes += bytes;
+
+  // first try sees size bytes, the retry all of them
+  for (size_t split = 0; split <= size; split++) {
+    rpc::Reader::SkipState state;
+    rpc::Reader first(bytes.data(), split);
+    bool done = first.TrySkip(state);
+    BOOST_REQUIRE_EQUAL(done, split == size);
+    BOOST_REQUIRE_EQUAL(first.Offset(), done ? size : 0);
+    if (!done) {
+      rpc::Reader retry(bytes.data(), bytes.size());
+      BOOST_REQUIRE(retry.TrySkip(state));
+      BOOST_REQUIRE_EQUAL(retry.Offset(), size);
+    }
+    BOOST_CHECK(state.offset == 0 && state.pending == 1);
+  }
+
+  // arriving one byte at a time, like OnRead with tiny reads
+  rpc::Reader::SkipState state;
+  size_t start = 0;
+  int messages = 0;
+  for (size_t end = start; end <= bytes.size(); end++) {
+    rpc::Reader reader(bytes.data() + start, end - start);
+    if (!reader.TrySkip(state)) continue;
+    BOOST_REQUIRE_EQUAL(reader.Offset(), size);
+    start += reader.Offset();
+    messages++;
+  }
+  BOOST_CHECK_EQUAL(messages, 2);
+}
+
+BOOST_AUTO_TEST_CASE(RawGridLineAndScroll) {
+  using namespace event;
+  auto message = PackRedraw();
+  rpc::Reader reader(message.data(), message.size());
+  reader.ReadArray();
+  reader.ReadInt();
+  reader.ReadStr();
+  auto params = reader.ReadRaw();
+
+  UiEvents uiEvents;
+  ParseUiRedraw(params, rpc::ZonePool::Shared().Acquire(), uiEvents);
+  uiEvents.TakeReady();
+  BOOST_REQUIRE_EQUAL(uiEvents.queue.size(), 1u);
+  auto& events = uiEvents.queue.front().events;
+  BOOST_REQUIRE_EQUAL(events.size(), 3u);
+
+  auto& line = std::get<GridLine>(events[0]);
+  BOOST_CHECK_EQUAL(line.grid, 1);
+  BOOST_CHECK_EQUAL(line.row, 2);
+  BOOST_CHECK_EQUAL(line.colStart, 1);
+  BOOST_CHECK(line.wrap);
+  BOOST_REQUIRE_EQUAL(line.cells.size(), 4u);
+  BOOST_CHECK_EQUAL(line.cells[0].text, "a");
+  BOOST_CHECK_EQUAL(*line.cells[0].hlId, 3);
+  BOOST_CHECK_EQUAL(line.cells[1].text, "字");
+  BOOST_CHECK(!line.cells[1].hlId && !line.cells[1].repeat);
+  BOOST_CHECK(line.cells[2].text.empty());
+  BOOST_CHECK_EQUAL(*line.cells[3].hlId, 0);
+  BOOST_CHECK_EQUAL(*line.cells[3].repeat, 70000);
+
+  auto& scroll = std::get<GridScroll>(events[1]);
+  BOOST_CHECK(scroll.top == 0 && scroll.bot == 10 && scroll.right == 20);
+  BOOST_CHECK_EQUAL(scroll.rows, -3);
+  BOOST_CHECK(std::holds_alternative<Flush>(events[2]));
+  uiEvents.Recycle();
+}
+
+BOOST_AUTO_TEST_CASE(UiEventBatchRecycle) {
+  using namespace event;
+  msgpack::sbuffer params;
+  msgpack::pack(params, std::tuple(
+    std::tuple("grid_line", std::tuple(1, 2, 0, std::tuple(
+      std::tuple("a", 3), std::tuple("b"), std::tuple(" ", 0, 5)
+    ), false)),
+    std::tuple("flush", std::tuple())
+  ));
+
+  UiEvents uiEvents;
+  size_t capacity = 0;
+  for (int i = 0; i < 3; i++) {
+    ParseUiRedraw({params.data(), params.size()}, rpc::ZonePool::Shared().Acquire(), uiEvents);
+    uiEvents.TakeReady();
+    BOOST_REQUIRE_EQUAL(uiEvents.queue.size(), 1u);
+
+    auto& batch = uiEvents.queue.front();
+    BOOST_REQUIRE_EQUAL(batch.events.size(), 2u);
+    auto& line = std::get<GridLine>(batch.events[0]);
+    BOOST_REQUIRE_EQUAL(line.cells.size(), 3u);
+    BOOST_CHECK_EQUAL(line.row, 2);
+    BOOST_CHECK_EQUAL(line.cells[0].text, "a");
+    BOOST_CHECK_EQUAL(*line.cells[0].hlId, 3);
+    BOOST_CHECK_EQUAL(*line.cells[2].repeat, 5);
+    BOOST_CHECK(std::holds_alternative<Flush>(batch.events[1]));
+
+    // batches are reused without growing
+    if (i == 0) capacity = batch.arena.Capacity();
+    BOOST_CHECK_EQUAL(batch.arena.Capacity(), capacity);
+    uiEvents.Recycle();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TraceRingWrap) {
+  // recorded only while enabled
+  { trace::Scope scope("ignored"); }
+  trace::SetEnabled(true);
+
+  size_t numEvents = trace::ThreadBuffer::capacity + 100;
+  for (size_t i = 0; i < numEvents; i++) {
+    trace::Counter("counter", i);
+  }
+  { trace::Scope scope("scope"); }
+  std::jthread([] { trace::Instant("other_thread", 1); }).join();
+  trace::SetEnabled(false);
+
+  uint32_t tid = trace::LocalBuffer().tid;
+  std::vector<trace::Event> events;
+  bool otherThread = false;
+  for (auto& e : trace::Snapshot()) {
+    if (e.tid == tid) events.push_back(e);
+    otherThread |= std::string_view(e.name) == "other_thread";
+  }
+  BOOST_CHECK(otherThread);
+
+  // the oldest were overwritten, and the oldest left is dropped as it
+  // could be half written when the writer runs during the snapshot
+  BOOST_REQUIRE_EQUAL(events.size(), trace::ThreadBuffer::capacity - 1);
+  BOOST_CHECK_EQUAL(events.front().value, 102);
+  BOOST_CHECK(events.back().phase == trace::Phase::Complete);
+  BOOST_CHECK_EQUAL(std::string_view(events.back().name), "scope");
+
+  auto path = std::filesystem::temp_directory_path() / "neogurt_rpc_test_trace.json";
+  BOOST_CHECK(trace::WriteChromeTrace(path));
+  BOOST_CHECK_GT(std::filesystem::file_size(path), 0u);
+  std::filesystem::remove(path);
+}
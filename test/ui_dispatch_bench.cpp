@@ -0,0 +1,106 @@
+#include "event/ui_parse.hpp"
+#include "nvim/msgpack_rpc/message_internal.hpp"
+#include "nvim/msgpack_rpc/recording.hpp"
+#include <chrono>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compares redraw event name dispatch in ParseUiRedraw (UiEventIndex, a
+// compile time perfect hash) against the std::unordered_map it replaced.
+// Event names are taken from a recording (neogurt --record_rpc <path>) in
+// order, or from a typing-like mix if none is given.
+//
+// usage: ui_dispatch_bench [recording] [rounds]
+
+using namespace std::chrono;
+
+// every event name of every redraw notification, in order
+static std::vector<std::string> ReadEventNames(const std::string& path) {
+  std::vector<std::string> names;
+  rpc::Replayer replayer;
+  if (!replayer.Open(path, false)) return names;
+
+  msgpack::unpacker unpacker;
+  while (true) {
+    unpacker.reserve_buffer(1 << 16);
+    boost::system::error_code ec;
+    size_t length =
+      replayer.ReadSome(boost::asio::buffer(unpacker.buffer(), 1 << 16), ec);
+    if (ec) break;
+    unpacker.buffer_consumed(length);
+
+    msgpack::object_handle handle;
+    while (unpacker.next(handle)) {
+      const auto& obj = handle.get();
+      int type = obj.via.array.ptr[0].convert();
+      if (type != rpc::MessageType::Notification) continue;
+      rpc::NotificationIn notif(obj.convert());
+      if (notif.method != "redraw") continue;
+
+      const auto& events = notif.params.via.array;
+      for (uint32_t i = 0; i < events.size; i++) {
+        const auto& event = events.ptr[i].via.array;
+        if (event.size == 0) continue;
+        names.push_back(event.ptr[0].as<std::string>());
+      }
+    }
+  }
+  return names;
+}
+
+static std::vector<std::string> TypingNames() {
+  std::vector<std::string> names;
+  for (int i = 0; i < 10000; i++) {
+    names.insert(names.end(), {"grid_line", "grid_cursor_goto", "win_viewport", "flush"});
+    if (i % 10 == 0) names.insert(names.end(), {"hl_attr_define", "grid_scroll"});
+    if (i % 50 == 0) names.insert(names.end(), {"mode_change", "msg_showmode"});
+  }
+  return names;
+}
+
+int main(int argc, char* argv[]) {
+  std::string source = argc > 1 ? argv[1] : "typing mix";
+  int rounds = argc > 2 ? std::stoi(argv[2]) : 100;
+
+  auto names = argc > 1 ? ReadEventNames(argv[1]) : TypingNames();
+  if (names.empty()) {
+    std::println("no redraw events in {}", source);
+    return 1;
+  }
+  std::vector<std::string_view> views(names.begin(), names.end());
+
+  std::unordered_map<std::string_view, int> map;
+  auto handled = UiEventNames();
+  for (size_t i = 0; i < handled.size(); i++) map.emplace(handled[i], i);
+
+  // sum of indices, so the lookups aren't optimized away
+  auto Run = [&](auto&& lookup) {
+    long sum = 0;
+    auto start = steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (auto name : views) sum += lookup(name);
+    }
+    double ns = duration<double, std::nano>(steady_clock::now() - start).count();
+    return std::pair(ns / (double(rounds) * views.size()), sum);
+  };
+
+  auto [mapNs, mapSum] = Run([&](std::string_view name) {
+    auto it = map.find(name);
+    return it == map.end() ? -1 : it->second;
+  });
+  auto [hashNs, hashSum] = Run([](std::string_view name) { return UiEventIndex(name); });
+
+  size_t unknown = 0;
+  for (auto name : views) unknown += UiEventIndex(name) < 0;
+
+  std::println("events:        {} from {}, {} unknown", views.size(), source, unknown);
+  std::println("unordered_map: {:.2f}ns per event", mapNs);
+  std::println("perfect hash:  {:.2f}ns per event ({:.1f}x)", hashNs, mapNs / hashNs);
+  if (mapSum != hashSum) {
+    std::println("mismatch: results differ");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,540 @@
+#define BOOST_TEST_MODULE UiTest
+#include <boost/test/included/unit_test.hpp>
+
+#include "nvim/msgpack_rpc/client.hpp"
+#include "nvim/msgpack_rpc/recording.hpp"
+#include "event/ui_compact.hpp"
+#include "event/ui_parse.hpp"
+#include "editor/grid.hpp"
+#include "editor/highlight.hpp"
+#include "utils/variant.hpp"
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Redraw compaction (GridEventCompactor) must leave the grids exactly as
+// applying every event does. Recordings given after -- are replayed and
+// compared too: ui_test -- <recording>...
+
+using namespace event;
+using Cell = GridLine::Cell;
+
+static GridLine Line(Arena& arena, int row, int col, std::initializer_list<Cell> cells) {
+  auto span = arena.MakeArray<Cell>(cells.size());
+  std::ranges::copy(cells, span.begin());
+  return GridLine{.grid = 1, .row = row, .colStart = col, .cells = span, .wrap = false};
+}
+
+static std::vector<UiEvent*> Pointers(std::vector<UiEvent>& events) {
+  std::vector<UiEvent*> pointers;
+  for (auto& event : events) pointers.push_back(&event);
+  return pointers;
+}
+
+BOOST_AUTO_TEST_CASE(OverwrittenLineDropped) {
+  Arena arena;
+  std::vector<UiEvent> events{
+    Line(arena, 0, 2, {{"a", 1}, {"b"}}),
+    Line(arena, 0, 0, {{" ", 0, 6}}),
+    Line(arena, 1, 0, {{"c", 1}}),
+  };
+  auto gridEvents = Pointers(events);
+
+  GridEventCompactor compactor;
+  auto stats = compactor.Compact(gridEvents, arena);
+  BOOST_CHECK_EQUAL(stats.droppedEvents, 1u);
+  BOOST_CHECK_EQUAL(stats.droppedCells, 2u);
+  BOOST_REQUIRE_EQUAL(gridEvents.size(), 2u);
+  BOOST_CHECK(gridEvents[0] == &events[1]);
+}
+
+BOOST_AUTO_TEST_CASE(PartlyCoveredLineTrimmed) {
+  Arena arena;
+  std::vector<UiEvent> events{
+    Line(arena, 0, 0, {{"a", 1}, {"b", {}, 3}, {"c", 2}, {"d"}}),
+    Line(arena, 0, 0, {{"x", 0, 2}}),
+    Line(arena, 0, 5, {{"y", 0}}),
+  };
+  auto gridEvents = Pointers(events);
+
+  GridEventCompactor compactor;
+  auto stats = compactor.Compact(gridEvents, arena);
+  BOOST_CHECK_EQUAL(stats.droppedEvents, 0u);
+  BOOST_CHECK_EQUAL(stats.droppedCells, 3u);
+
+  // the repeat is split and keeps the hl of the dropped cell before it
+  auto& line = std::get<GridLine>(events[0]);
+  BOOST_CHECK_EQUAL(line.colStart, 2);
+  BOOST_REQUIRE_EQUAL(line.cells.size(), 2u);
+  BOOST_CHECK_EQUAL(line.cells[0].text, "b");
+  BOOST_CHECK_EQUAL(*line.cells[0].hlId, 1);
+  BOOST_CHECK_EQUAL(*line.cells[0].repeat, 2);
+  BOOST_CHECK_EQUAL(line.cells[1].text, "c");
+}
+
+BOOST_AUTO_TEST_CASE(ClearCollapsesRewrite) {
+  Arena arena;
+  std::vector<UiEvent> events{
+    Line(arena, 3, 0, {{"a", 1}}),
+    GridScroll{1, 0, 10, 0, 20, 1, 0},
+    GridClear{1},
+    Line(arena, 0, 0, {{"~", 2}, {" ", 0, 19}}),
+    Line(arena, 1, 0, {{" ", 0, 20}}),
+  };
+  auto gridEvents = Pointers(events);
+
+  GridEventCompactor compactor;
+  auto stats = compactor.Compact(gridEvents, arena);
+  BOOST_CHECK_EQUAL(stats.droppedEvents, 3u);
+  BOOST_REQUIRE_EQUAL(gridEvents.size(), 2u);
+  BOOST_CHECK(std::holds_alternative<GridClear>(*gridEvents[0]));
+  auto& line = std::get<GridLine>(*gridEvents[1]);
+  BOOST_CHECK_EQUAL(line.cells.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(LineDamagesRow) {
+  Arena arena;
+  GridManager grids;
+  grids.Resize({1, 10, 6});
+  auto& damage = grids.grids.at(1).damage;
+  BOOST_CHECK(damage[0] && damage[5]);
+  damage.Clear();
+  BOOST_CHECK(damage.Empty());
+
+  grids.Line(Line(arena, 1, 0, {{"a", 1}}));
+  grids.Line(Line(arena, 2, 3, {{"b", 1}}));
+  grids.Line(Line(arena, 4, 0, {{"c", 1}}));
+  std::vector<std::pair<int, int>> runs;
+  damage.ForEachRun(0, 6, [&](int start, int end) { runs.emplace_back(start, end); });
+  BOOST_REQUIRE_EQUAL(runs.size(), 2u);
+  BOOST_CHECK(runs[0] == std::pair(1, 3));
+  BOOST_CHECK(runs[1] == std::pair(4, 5));
+
+  // runs are cut to the range asked for
+  runs.clear();
+  damage.ForEachRun(2, 4, [&](int start, int end) { runs.emplace_back(start, end); });
+  BOOST_REQUIRE_EQUAL(runs.size(), 1u);
+  BOOST_CHECK(runs[0] == std::pair(2, 3));
+
+  damage.Clear();
+  grids.Scroll({1, 2, 5, 0, 10, 1, 0});
+  BOOST_CHECK(!damage[1] && damage[2] && damage[4] && !damage[5]);
+}
+
+BOOST_AUTO_TEST_CASE(ScrollMovesDamage) {
+  Arena arena;
+  GridManager grids;
+  grids.Resize({1, 10, 6});
+  auto& damage = grids.grids.at(1).damage;
+  damage.Clear();
+
+  // changed row moves with its content, the exposed row is changed
+  grids.Line(Line(arena, 3, 0, {{"a", 1}}));
+  grids.Scroll({1, 0, 6, 0, 10, 1, 0});
+  BOOST_CHECK_EQUAL(damage.Scrolled(), 1);
+  BOOST_CHECK(damage.IsMoved(0) && !damage.IsChanged(0));
+  BOOST_CHECK(damage.IsMoved(2) && damage.IsChanged(2));
+  BOOST_CHECK(!damage.IsMoved(5) && damage.IsChanged(5));
+
+  grids.Scroll({1, 0, 6, 0, 10, -2, 0});
+  BOOST_CHECK_EQUAL(damage.Scrolled(), -1);
+  BOOST_CHECK(damage.IsChanged(0) && damage.IsChanged(1));
+  BOOST_CHECK(damage.IsMoved(2) && !damage.IsChanged(2));
+  BOOST_CHECK(damage.IsChanged(4));
+
+  // another region or part of the columns can't be reused
+  grids.Scroll({1, 1, 4, 0, 10, 1, 0});
+  BOOST_CHECK_EQUAL(damage.Scrolled(), 1);
+  BOOST_CHECK(damage.IsChanged(2));
+  BOOST_CHECK(!damage.IsMoved(5) && damage.IsChanged(5));
+  damage.Clear();
+  grids.Scroll({1, 0, 6, 2, 10, 1, 0});
+  BOOST_CHECK_EQUAL(damage.Scrolled(), 0);
+  BOOST_CHECK(!damage.IsMoved(0) && damage.IsChanged(0));
+}
+
+BOOST_AUTO_TEST_CASE(HighlightChangesDamageAll) {
+  Arena arena;
+  GridManager grids;
+  HlManager hlManager;
+  hlManager.gridManager = &grids;
+  grids.Resize({1, 4, 3});
+  grids.Resize({2, 2, 2});
+  auto clear = [&] {
+    for (auto& [id, grid] : grids.grids) {
+      grid.damage.Clear();
+      grid.dirty = false;
+    }
+  };
+  auto allDamaged = [&] {
+    bool all = true;
+    for (auto& [id, grid] : grids.grids) {
+      all &= grid.dirty;
+      for (int row = 0; row < grid.height; row++) all &= grid.damage.IsChanged(row);
+    }
+    return all;
+  };
+
+  clear();
+  hlManager.DefaultColorsSet({0xffffff, 0x101010, 0xff0000, 0, 0});
+  BOOST_CHECK(allDamaged());
+
+  clear();
+  hlManager.SetOpacity(0.5, 0x202020);
+  BOOST_CHECK(allDamaged());
+
+  // a new id isn't drawn yet, a redefined one is
+  clear();
+  hlManager.HlAttrDefine({.id = 5, .rgbAttrs = {.foreground = 0x00ff00}});
+  BOOST_CHECK(grids.grids.at(1).damage.Empty() && !grids.grids.at(1).dirty);
+  grids.Line(Line(arena, 0, 0, {{"a", 5}}));
+  clear();
+  hlManager.HlAttrDefine({.id = 5, .rgbAttrs = {.foreground = 0x0000ff}});
+  BOOST_CHECK(allDamaged());
+}
+
+BOOST_AUTO_TEST_CASE(PartialScrollAndResizeKeepLines) {
+  Arena arena;
+  GridManager grids;
+  grids.Resize({1, 4, 5});
+  auto& grid = grids.grids.at(1);
+  auto text = [&](int row, int col) { return grid.Text(grid.lines[row][col]); };
+  for (int row = 0; row < 5; row++) {
+    std::string c(1, char('a' + row));
+    grids.Line(Line(arena, row, 0, {{c, 1}, {c}, {c}, {c}}));
+  }
+
+  // whole lines are swapped, column ranges copied
+  grids.Scroll({1, 1, 4, 0, 4, 1, 0});
+  BOOST_CHECK(text(0, 0) == "a" && text(1, 0) == "c" && text(2, 0) == "d");
+  BOOST_CHECK_EQUAL(text(4, 0), "e");
+  grids.Scroll({1, 0, 5, 2, 4, -1, 0});
+  BOOST_CHECK(text(1, 0) == "c" && text(1, 2) == "a" && text(2, 3) == "c");
+
+  grids.Resize({1, 3, 6});
+  BOOST_CHECK_EQUAL(grid.lines.Size(), 6u);
+  BOOST_CHECK_EQUAL(grid.lines[0].size(), 3u);
+  BOOST_CHECK(text(0, 0) == "a" && text(1, 2) == "a" && text(4, 0) == "e");
+  BOOST_CHECK_EQUAL(text(5, 0), " ");
+
+  grids.Resize({1, 5, 2});
+  BOOST_CHECK(text(1, 0) == "c" && text(1, 3) == " ");
+}
+
+BOOST_AUTO_TEST_CASE(GraphemeInternRoundTrip) {
+  GraphemeTable table;
+  // ascii is its own id, never stored
+  size_t size = table.Size();
+  BOOST_CHECK_EQUAL(table.Intern("a"), GraphemeTable::Id('a'));
+  BOOST_CHECK_EQUAL(table.Intern(" "), GraphemeTable::space);
+  BOOST_CHECK_EQUAL(table.Intern(""), GraphemeTable::empty);
+  BOOST_CHECK_EQUAL(table.Text('a'), "a");
+  BOOST_CHECK_EQUAL(table.Text(GraphemeTable::empty), "");
+  BOOST_CHECK_EQUAL(table.Size(), size);
+
+  for (std::string text : {"字", "é", "ab", "👍🏽", "\x7f"}) {
+    auto id = table.Intern(text);
+    BOOST_CHECK_EQUAL(table.Text(id), text);
+    BOOST_CHECK_EQUAL(table.Intern(text), id);
+  }
+  BOOST_CHECK_EQUAL(table.Size(), size + 4);
+}
+
+BOOST_AUTO_TEST_CASE(GraphemeTableBounded) {
+  Arena arena;
+  GridManager grids;
+  grids.graphemeLimit = 300;
+  grids.Resize({1, 4, 2});
+  grids.Resize({2, 2, 1});
+  grids.Line(Line(arena, 0, 0, {{"字", 1}, {""}, {"é"}}));
+  auto other = Line(arena, 0, 0, {{"ü", 1}});
+  other.grid = 2;
+  grids.Line(other);
+
+  // a new grapheme per line, far more than the limit
+  for (int i = 0; i < 2000; i++) {
+    auto text = "x" + std::to_string(i);
+    grids.Line(Line(arena, 1, 0, {{text, 2}, {"b"}}));
+    auto& grid = grids.grids.at(1);
+    BOOST_REQUIRE_EQUAL(grid.Text(grid.lines[1][0]), text);
+  }
+  BOOST_CHECK_LE(grids.graphemes->Size(), 300u + 1);
+
+  // live cells keep their text across rebuilds
+  auto& grid = grids.grids.at(1);
+  BOOST_CHECK_EQUAL(grid.Text(grid.lines[0][0]), "字");
+  BOOST_CHECK_EQUAL(grid.Text(grid.lines[0][1]), "");
+  BOOST_CHECK_EQUAL(grid.Text(grid.lines[0][2]), "é");
+  BOOST_CHECK_EQUAL(grid.Text(grid.lines[1][1]), "b");
+  auto& otherGrid = grids.grids.at(2);
+  BOOST_CHECK(otherGrid.graphemes == grids.graphemes.get());
+  BOOST_CHECK_EQUAL(otherGrid.Text(otherGrid.lines[0][0]), "ü");
+}
+
+// replay ------------------------------------------
+
+// packs redraw notifications, one per flush
+struct RedrawWriter {
+  struct TestCell {
+    std::string text;
+    int hlId = -1;
+    int repeat = 0;
+
+    template <typename Stream>
+    void msgpack_pack(msgpack::packer<Stream>& o) const {
+      o.pack_array(repeat ? 3 : hlId >= 0 ? 2 : 1);
+      o.pack(text);
+      if (hlId >= 0 || repeat) o.pack(hlId < 0 ? 0 : hlId);
+      if (repeat) o.pack(repeat);
+    }
+  };
+
+  msgpack::sbuffer stream;
+  std::vector<msgpack::sbuffer> events;
+
+  template <typename... Args>
+  void Event(std::string_view name, const Args&... args) {
+    msgpack::packer packer(events.emplace_back());
+    packer.pack_array(2);
+    packer.pack(name);
+    packer.pack(std::tuple(args...));
+  }
+
+  void Line(int row, int col, const std::vector<TestCell>& cells) {
+    Event("grid_line", 1, row, col, cells, false);
+  }
+
+  void Flush() {
+    Event("flush");
+    msgpack::packer packer(stream);
+    packer.pack_array(3);
+    packer.pack(2);
+    packer.pack("redraw");
+    packer.pack_array(events.size());
+    for (auto& event : events) stream.write(event.data(), event.size());
+    events.clear();
+  }
+};
+
+// one cell per char, hl set on the first
+static std::vector<RedrawWriter::TestCell> Text(std::string_view text, int hlId) {
+  std::vector<RedrawWriter::TestCell> cells;
+  for (char c : text) cells.push_back({.text = std::string(1, c)});
+  if (!cells.empty()) cells[0].hlId = hlId;
+  return cells;
+}
+
+// a session like nvim sends it: startup, typing, scrolling, wide chars,
+// a colorscheme switch, then random flushes
+static msgpack::sbuffer ScriptedSession(int width, int height) {
+  RedrawWriter w;
+  using TestCell = RedrawWriter::TestCell;
+
+  w.Event("grid_resize", 1, width, height);
+  w.Event("grid_clear", 1);
+  for (int row = 0; row < height; row++) {
+    w.Line(row, 0, {{"~", 1}, {" ", 0, width - 1}});
+  }
+  w.Event("grid_cursor_goto", 1, 0, 0);
+  w.Flush();
+
+  std::string text;
+  for (int i = 0; i < 30; i++) {
+    text += char('a' + i % 26);
+    w.Line(0, 0, Text(text, 0));
+    w.Line(0, 0, Text(text.substr(0, 2), 2));
+    w.Line(height - 1, 0, Text("-- INSERT --", 3));
+    w.Line(height - 1, 12, {{" ", 0, width - 12}});
+    w.Line(height - 1, width - 6, Text(std::to_string(i), 3));
+    w.Event("grid_cursor_goto", 1, 0, i % width);
+    w.Flush();
+  }
+
+  for (int i = 0; i < 20; i++) {
+    w.Event("grid_scroll", 1, 0, height - 1, 0, width, 1, 0);
+    w.Line(height - 2, 0, Text("line", 0));
+    w.Line(height - 2, 4, {{" ", 0, width - 4}});
+    w.Line(height - 2, 0, Text(std::to_string(i), 4));
+    w.Flush();
+  }
+
+  for (int i = 0; i < 10; i++) {
+    w.Line(2, 0, {{"字", 5}, {""}, {"字"}, {""}, {"a"}, {" ", 0, 3}});
+    w.Line(2, 3 + i % 4, {{"b", 6}, {"字"}, {""}});
+    w.Flush();
+  }
+
+  w.Event("grid_clear", 1);
+  for (int row = 0; row < height; row++) {
+    w.Line(row, 0, {{"~", 7}, {" ", 0, width - 1}});
+  }
+  for (int row = 0; row < height; row += 2) {
+    w.Line(row, 0, {{"x", 8, width / 2}});
+  }
+  w.Flush();
+
+  std::mt19937 rng(1);
+  auto Rand = [&](int n) { return int(rng() % n); };
+  for (int i = 0; i < 500; i++) {
+    int numEvents = 1 + Rand(12);
+    for (int j = 0; j < numEvents; j++) {
+      int kind = Rand(12);
+      if (kind < 9) {
+        std::vector<TestCell> cells;
+        int col = Rand(width);
+        for (int c = col; c < width && (cells.empty() || Rand(4));) {
+          TestCell cell{.text = std::string(1, " ab"[Rand(3)])};
+          if (cells.empty() || Rand(2)) cell.hlId = Rand(3);
+          if (Rand(5) == 0 && c + 2 <= width) {
+            cell.text = "字";
+            cells.push_back(cell);
+            cells.push_back({""});
+            c += 2;
+            continue;
+          }
+          if (Rand(3) == 0) {
+            cell.hlId = std::max(cell.hlId, 0);
+            cell.repeat = 1 + Rand(std::min(6, width - c));
+          }
+          c += std::max(cell.repeat, 1);
+          cells.push_back(cell);
+        }
+        w.Line(Rand(height), col, cells);
+      } else if (kind == 9) {
+        w.Event("grid_clear", 1);
+      } else if (kind == 10) {
+        int top = Rand(height - 1);
+        w.Event("grid_scroll", 1, top, height, 0, width, Rand(2) ? 1 : -1, 0);
+      } else {
+        w.Event("grid_cursor_goto", 1, Rand(height), Rand(width));
+      }
+    }
+    w.Flush();
+  }
+  return std::move(w.stream);
+}
+
+struct ReplayResult {
+  GridManager gridManager;
+  GridEventCompactor::Stats stats;
+  size_t numEvents = 0;
+};
+
+// applies the grid events of a recording like ProcessUiEvents does
+static ReplayResult Replay(const std::string& path, bool compact) {
+  ReplayResult result;
+  auto uiEvents = std::make_shared<UiEvents>();
+  auto client = std::make_shared<rpc::Client>();
+  client->SetRawNotification("redraw", [uiEvents](rpc::Notification&& notif) {
+    ParseUiRedraw(notif.rawParams, std::move(notif._zone), *uiEvents);
+  });
+  BOOST_REQUIRE(client->ConnectReplay(path));
+
+  GridEventCompactor compactor;
+  std::vector<UiEvent*> gridEvents;
+  auto& grids = result.gridManager;
+  while (true) {
+    // checked first, everything read before the disconnect is ready below
+    bool connected = client->IsConnected();
+
+    uiEvents->TakeReady();
+    for (UiEventBatch& batch : uiEvents->queue) {
+      gridEvents.clear();
+      for (UiEvent& event : batch.events) {
+        std::visit(overloaded{
+          [&](GridResize&) { gridEvents.push_back(&event); },
+          [&](GridClear&) { gridEvents.push_back(&event); },
+          [&](GridLine&) { gridEvents.push_back(&event); },
+          [&](GridScroll&) { gridEvents.push_back(&event); },
+          [&](GridDestroy&) { gridEvents.push_back(&event); },
+          [&](auto&) {},
+        }, event);
+      }
+
+      if (compact) {
+        auto stats = compactor.Compact(gridEvents, batch.arena);
+        result.stats.droppedEvents += stats.droppedEvents;
+        result.stats.droppedCells += stats.droppedCells;
+      }
+      result.numEvents += gridEvents.size();
+
+      for (UiEvent* event : gridEvents) {
+        std::visit(overloaded{
+          [&](GridResize& e) { grids.Resize(e); },
+          [&](GridClear& e) { grids.Clear(e); },
+          [&](GridLine& e) { grids.Line(e); },
+          [&](GridScroll& e) { grids.Scroll(e); },
+          [&](GridDestroy& e) { grids.Destroy(e); },
+          [&](auto&) {},
+        }, *event);
+      }
+    }
+    uiEvents->Recycle();
+    client->DrainMessages([](rpc::Message&) {});
+
+    if (!connected) break;
+    std::this_thread::yield();
+  }
+  return result;
+}
+
+static void CheckSameGrids(const GridManager& expected, const GridManager& actual) {
+  BOOST_REQUIRE_EQUAL(expected.grids.size(), actual.grids.size());
+  for (const auto& [id, grid] : expected.grids) {
+    auto it = actual.grids.find(id);
+    BOOST_REQUIRE(it != actual.grids.end());
+    const auto& other = it->second;
+    BOOST_REQUIRE_EQUAL(grid.width, other.width);
+    BOOST_REQUIRE_EQUAL(grid.height, other.height);
+
+    size_t mismatches = 0;
+    for (int row = 0; row < grid.height; row++) {
+      for (int col = 0; col < grid.width; col++) {
+        const auto& a = grid.lines[row][col];
+        const auto& b = other.lines[row][col];
+        // ids depend on interning order, compare the text
+        mismatches += grid.Text(a) != other.Text(b) || a.hlId != b.hlId ||
+                      a.doubleWidth != b.doubleWidth;
+      }
+    }
+    BOOST_CHECK_MESSAGE(mismatches == 0, "grid " << id << ": " << mismatches << " cells differ");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompactedReplayMatches) {
+  auto path = (std::filesystem::temp_directory_path() / "neogurt_ui_test.rec").string();
+  {
+    auto stream = ScriptedSession(40, 12);
+    rpc::Recorder recorder;
+    BOOST_REQUIRE(recorder.Open(path));
+    recorder.Write({stream.data(), stream.size()});
+  }
+
+  auto full = Replay(path, false);
+  auto compacted = Replay(path, true);
+  CheckSameGrids(full.gridManager, compacted.gridManager);
+  BOOST_CHECK_GT(compacted.stats.droppedEvents, 0u);
+  BOOST_CHECK_EQUAL(full.numEvents, compacted.numEvents + compacted.stats.droppedEvents);
+  BOOST_TEST_MESSAGE(
+    "scripted session: " << compacted.stats.droppedEvents << " of " << full.numEvents
+    << " grid events, " << compacted.stats.droppedCells << " cells dropped"
+  );
+
+  std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(CompactedRecordingsMatch) {
+  auto& suite = boost::unit_test::framework::master_test_suite();
+  for (int i = 1; i < suite.argc; i++) {
+    std::string path = suite.argv[i];
+    auto full = Replay(path, false);
+    auto compacted = Replay(path, true);
+    CheckSameGrids(full.gridManager, compacted.gridManager);
+    BOOST_TEST_MESSAGE(
+      path << ": " << compacted.stats.droppedEvents << " of " << full.numEvents
+      << " grid events, " << compacted.stats.droppedCells << " cells dropped"
+    );
+  }
+}